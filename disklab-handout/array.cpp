@@ -0,0 +1,378 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief disk arrays (RAID-0/1/5) over HDD members
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iostream>
+
+#include "array.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// DiskArray
+//
+DiskArray* DiskArray::create(uint32 level, const vector<HDD*> &members,
+                             uint32 stripe, uint32 nthreads)
+{
+  size_t min_members = level == 5 ? 3 : level == 1 ? 2 : 1;
+
+  if ((level != 0) && (level != 1) && (level != 5)) {
+    cout << "Unsupported RAID level " << level << "." << endl;
+    return NULL;
+  }
+  if ((members.size() < min_members) || (members.size() > MAX_ARRAY_DISKS)) {
+    cout << "RAID-" << level << " requires " << min_members << ".."
+         << MAX_ARRAY_DISKS << " disks." << endl;
+    return NULL;
+  }
+  if (stripe == 0) {
+    cout << "The stripe unit must be at least one block." << endl;
+    return NULL;
+  }
+  for (size_t i=1; i<members.size(); i++) {
+    if (members[i]->capacity() != members[0]->capacity()) {
+      cout << "The disks of an array must have the same capacity." << endl;
+      return NULL;
+    }
+  }
+
+  return new DiskArray(level, members, stripe, nthreads);
+}
+
+DiskArray::DiskArray(uint32 level, const vector<HDD*> &members, uint32 stripe,
+                     uint32 nthreads)
+  : _level(level), _disk(members), _stripe(stripe), _pool(NULL),
+    _busy(members.size(), 0.0), _full_stripe(0), _rmw(0),
+    _sub(members.size()), _cursor(members.size(), 0.0)
+{
+  uint32 n = _disk.size();
+  uint64 units = _disk[0]->capacity() / _disk[0]->bytes_per_sector() / stripe;
+
+  switch (_level) {
+    case 0: _blocks = units * n * stripe; break;
+    case 1: _blocks = units * stripe; break;
+    default: _blocks = units * (n-1) * stripe; break;
+  }
+
+  // RAID-5 writes couple the members, see access()
+  if ((nthreads != 1) && (n > 1) && (_level != 5)) {
+    _pool = new WorkPool(nthreads);
+  }
+}
+
+DiskArray::~DiskArray(void)
+{
+  delete _pool;
+  for (size_t i=0; i<_disk.size(); i++) delete _disk[i];
+}
+
+uint32 DiskArray::level(void) const
+{
+  return _level;
+}
+
+uint32 DiskArray::stripe(void) const
+{
+  return _stripe;
+}
+
+uint32 DiskArray::members(void) const
+{
+  return _disk.size();
+}
+
+const HDD* DiskArray::member(uint32 i) const
+{
+  return _disk[i];
+}
+
+uint64 DiskArray::blocks(void) const
+{
+  return _blocks;
+}
+
+double DiskArray::busy(uint32 i) const
+{
+  return _busy[i];
+}
+
+uint64 DiskArray::full_stripe_writes(void) const
+{
+  return _full_stripe;
+}
+
+uint64 DiskArray::rmw_writes(void) const
+{
+  return _rmw;
+}
+
+double DiskArray::read(double ts, uint64 block, uint64 nblocks)
+{
+  ArrayRequest r = { ts, 'r', block, nblocks };
+  return access(r);
+}
+
+double DiskArray::write(double ts, uint64 block, uint64 nblocks)
+{
+  ArrayRequest r = { ts, 'w', block, nblocks };
+  return access(r);
+}
+
+void DiskArray::locate(uint64 block, uint32 *member, uint64 *mblock) const
+{
+  uint32 n = _disk.size();
+  uint64 unit = block / _stripe, off = block % _stripe;
+
+  if (_level == 5) {
+    uint64 row = unit / (n-1);
+    uint32 parity = n-1 - row % n;
+    *member = (parity + 1 + unit % (n-1)) % n;
+    *mblock = row * _stripe + off;
+  } else {
+    *member = unit % n;
+    *mblock = unit / n * _stripe + off;
+  }
+}
+
+void DiskArray::split(uint32 req, const ArrayRequest &r)
+{
+  bool write = r.rw == 'w';
+  SubRequest s = { req, 0, r.block, r.nblocks, write, r.ts, 0.0 };
+
+  //
+  // mirrors: the whole request goes to one or all members
+  //
+  if (_level == 1) {
+    for (uint32 m=0; m<_disk.size(); m++) {
+      if (!write && (m != r.block / _stripe % _disk.size())) continue;
+      s.member = m;
+      _sub[m].push_back(s);
+    }
+    return;
+  }
+
+  //
+  // striping: one sub-request per unit; the units of a member are merged
+  // if they are contiguous on the member
+  //
+  uint64 b = r.block, left = r.nblocks;
+  while (left > 0) {
+    uint64 n = min(left, _stripe - b % _stripe);
+    locate(b, &s.member, &s.block);
+    s.nblocks = n;
+
+    vector<SubRequest> &q = _sub[s.member];
+    if (!q.empty() && (q.back().req == req) &&
+        (q.back().block + q.back().nblocks == s.block)) {
+      q.back().nblocks += n;
+    } else {
+      q.push_back(s);
+    }
+    b += n;
+    left -= n;
+  }
+}
+
+void DiskArray::serve(uint32 m)
+{
+  vector<SubRequest> &q = _sub[m];
+  double t = 0;
+
+  for (size_t i=0; i<q.size(); i++) {
+    // sub-requests of the same request follow each other on the member
+    if ((i == 0) || (q[i].req != q[i-1].req)) t = q[i].ts;
+    q[i].end = member_access(m, t, q[i].block, q[i].nblocks, q[i].write);
+    if (q[i].end >= 0) t = q[i].end;
+  }
+}
+
+double DiskArray::member_access(uint32 m, double start, uint64 block,
+                                uint64 nblocks, bool write)
+{
+  double end = write ? _disk[m]->write(start, block, nblocks)
+                     : _disk[m]->read(start, block, nblocks);
+
+  // failed accesses return negative times and take no time on the disk
+  if (end >= start) _busy[m] += end - start;
+  return end;
+}
+
+double DiskArray::write_row(double ts, uint64 row, uint64 block,
+                            uint64 nblocks)
+{
+  uint32 n = _disk.size(), parity = n-1 - row % n;
+  uint64 pblock = row * _stripe;
+  double end = ts;
+
+  //
+  // full row: write data and parity
+  //
+  if (nblocks == (uint64)(n-1) * _stripe) {
+    _full_stripe++;
+    for (uint32 m=0; m<n; m++) {
+      double e = member_access(m, _cursor[m], pblock, _stripe, true);
+      if (e < 0) return e;
+      _cursor[m] = e;
+      end = max(end, e);
+    }
+    return end;
+  }
+
+  //
+  // partial row: read the old data and the old parity of the blocks written,
+  // then write the new data and parity
+  //
+  _rmw++;
+  uint32 member[MAX_ARRAY_DISKS];
+  uint64 mblock[MAX_ARRAY_DISKS], len[MAX_ARRAY_DISKS], lo = _stripe, hi = 0;
+  uint32 k = 0;
+
+  for (uint64 b=block, left=nblocks; left>0; k++) {
+    len[k] = min(left, _stripe - b % _stripe);
+    locate(b, &member[k], &mblock[k]);
+    lo = min(lo, mblock[k] - pblock);
+    hi = max(hi, mblock[k] - pblock + len[k]);
+    b += len[k];
+    left -= len[k];
+  }
+  member[k] = parity;
+  mblock[k] = pblock + lo;
+  len[k] = hi - lo;
+  k++;
+
+  double read_end = ts;
+  for (uint32 i=0; i<k; i++) {
+    double e = member_access(member[i], _cursor[member[i]], mblock[i], len[i],
+                             false);
+    if (e < 0) return e;
+    _cursor[member[i]] = e;
+    read_end = max(read_end, e);
+  }
+  for (uint32 i=0; i<k; i++) {
+    double e = member_access(member[i], read_end, mblock[i], len[i], true);
+    if (e < 0) return e;
+    _cursor[member[i]] = e;
+    end = max(end, e);
+  }
+
+  return end;
+}
+
+double DiskArray::access(const ArrayRequest &r)
+{
+  if (r.block + r.nblocks > _blocks) {
+    cout << "DiskArray: request beyond the end of the array, block " << r.block
+         << endl;
+    return -1.1;
+  }
+
+  //
+  // RAID-5 writes: row by row
+  //
+  if ((_level == 5) && (r.rw == 'w')) {
+    uint64 row_blocks = (uint64)(_disk.size()-1) * _stripe;
+    double end = r.ts;
+
+    fill(_cursor.begin(), _cursor.end(), r.ts);
+    for (uint64 b=r.block, left=r.nblocks; left>0; ) {
+      uint64 n = min(left, row_blocks - b % row_blocks);
+      double e = write_row(r.ts, b / row_blocks, b, n);
+      if (e < 0) return e;
+      end = max(end, e);
+      b += n;
+      left -= n;
+    }
+    return end;
+  }
+
+  //
+  // everything else: independent sub-requests
+  //
+  double end = r.ts;
+  for (uint32 m=0; m<_disk.size(); m++) _sub[m].clear();
+  split(0, r);
+  for (uint32 m=0; m<_disk.size(); m++) {
+    serve(m);
+    for (size_t i=0; i<_sub[m].size(); i++) {
+      if (_sub[m][i].end < 0) return _sub[m][i].end;
+      end = max(end, _sub[m][i].end);
+    }
+  }
+  return end;
+}
+
+void DiskArray::access(const vector<ArrayRequest> &batch, vector<double> &end)
+{
+  end.resize(batch.size());
+
+  if (_level == 5) {
+    for (size_t i=0; i<batch.size(); i++) end[i] = access(batch[i]);
+    return;
+  }
+
+  //
+  // split the whole batch, simulate every member's sub-requests on their
+  // own (in parallel), then combine the completions
+  //
+  vector<bool> failed(batch.size(), false);
+  for (uint32 m=0; m<_disk.size(); m++) _sub[m].clear();
+  for (size_t i=0; i<batch.size(); i++) {
+    end[i] = batch[i].ts;
+    if (batch[i].block + batch[i].nblocks > _blocks) {
+      cout << "DiskArray: request beyond the end of the array, block "
+           << batch[i].block << endl;
+      end[i] = -1.1;
+      failed[i] = true;
+      continue;
+    }
+    split(i, batch[i]);
+  }
+
+  for (uint32 m=0; m<_disk.size(); m++) {
+    if (_sub[m].empty()) continue;
+    if (_pool != NULL) _pool->submit([this, m]() { serve(m); });
+    else serve(m);
+  }
+  if (_pool != NULL) _pool->wait();
+
+  for (uint32 m=0; m<_disk.size(); m++) {
+    for (size_t i=0; i<_sub[m].size(); i++) {
+      const SubRequest &s = _sub[m][i];
+      if (failed[s.req]) continue;
+      if (s.end < 0) {
+        end[s.req] = s.end;
+        failed[s.req] = true;
+      } else {
+        end[s.req] = max(end[s.req], s.end);
+      }
+    }
+  }
+}
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief disk arrays (RAID-0/1/5) over HDD members
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_ARRAY_H__
+#define __CA_ARRAY_H__
+
+#include <vector>
+
+#include "types.h"
+#include "disk.h"
+#include "hdd.h"
+#include "pool.h"
+using namespace std;
+
+#define MAX_ARRAY_DISKS 64          ///< max. number of members
+#define ARRAY_BATCH     4096        ///< requests per access() batch
+
+///@brief request to a disk array (in blocks)
+typedef struct ArrayRequest {
+  double ts;                        ///< arrival timestamp
+  char   rw;                        ///< 'r' or 'w'
+  uint64 block;                     ///< first block
+  uint64 nblocks;                   ///< number of blocks
+} ArrayRequest;
+
+//------------------------------------------------------------------------------
+/// @brief array of HDDs with striping (RAID-0), mirroring (RAID-1) or
+///        striping with distributed parity (RAID-5)
+///
+/// A request is split at stripe unit boundaries into sub-requests to the
+/// members. Sub-requests to the same member are served one after the other,
+/// members work in parallel; the request completes with its last
+/// sub-request. Like HDD, every request is served as if the array were idle
+/// at its arrival.
+///
+/// - RAID-0: unit u is on member u mod N at member block (u / N)*stripe.
+/// - RAID-1: every member holds all blocks. Writes go to all members; a
+///   read is served by member (first unit) mod N, which spreads the load
+///   without depending on the state of the members.
+/// - RAID-5: row r holds N-1 data units and a parity unit on member
+///   N-1 - r mod N (left-symmetric). A write that covers a whole row writes
+///   the data and the parity; otherwise the old data and parity are read
+///   first (read-modify-write) and the writes start when all reads of the
+///   row are done.
+///
+/// For RAID-0 and RAID-1, the sub-request streams of the members do not
+/// depend on each other, so access() simulates the members of a batch of
+/// requests in parallel on a thread pool. RAID-5 writes couple the members
+/// and are simulated sequentially.
+///
+class DiskArray : public Disk {
+  public:
+    /// @brief create a disk array
+    /// @param level RAID level (0, 1 or 5)
+    /// @param members member disks (owned by the array on success); all
+    ///        members must have the same capacity
+    /// @param stripe stripe unit in blocks
+    /// @param nthreads threads simulating the members in access()
+    ///        (0: number of cores, 1: sequential)
+    /// @retval DiskArray instance or NULL if the parameters are invalid
+    static DiskArray* create(uint32 level, const vector<HDD*> &members,
+                             uint32 stripe, uint32 nthreads=1);
+
+    /// @brief destructor; deletes the members
+    virtual ~DiskArray(void);
+
+    /// @name properties
+    /// @{
+
+    /// @brief RAID level
+    uint32 level(void) const;
+
+    /// @brief stripe unit in blocks
+    uint32 stripe(void) const;
+
+    /// @brief number of members
+    uint32 members(void) const;
+
+    /// @brief member @a i
+    const HDD* member(uint32 i) const;
+
+    /// @brief number of blocks visible to the user of the array
+    uint64 blocks(void) const;
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    virtual double read(double ts, uint64 block, uint64 nblocks);
+    virtual double write(double ts, uint64 block, uint64 nblocks);
+
+    /// @brief serve a batch of requests in order
+    /// @param batch requests
+    /// @param end (output) end[i]: time when batch[i] ends (negative if it
+    ///        failed)
+    void access(const vector<ArrayRequest> &batch, vector<double> &end);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief sum of the service times of the sub-requests of member @a i
+    double busy(uint32 i) const;
+
+    /// @brief number of RAID-5 rows written completely (no parity reads)
+    uint64 full_stripe_writes(void) const;
+
+    /// @brief number of RAID-5 rows updated by read-modify-write
+    uint64 rmw_writes(void) const;
+
+    /// @}
+
+  protected:
+    ///@brief part of a request on one member
+    typedef struct {
+      uint32 req;                   ///< request in the batch
+      uint32 member;                ///< member disk
+      uint64 block;                 ///< first member block
+      uint64 nblocks;               ///< number of blocks
+      bool   write;                 ///< write access
+      double ts;                    ///< arrival of the request
+      double end;                   ///< completion (set by serve())
+    } SubRequest;
+
+    uint32 _level;                  ///< RAID level
+    vector<HDD*> _disk;             ///< members
+    uint32 _stripe;                 ///< stripe unit in blocks
+    uint64 _blocks;                 ///< logical blocks
+    WorkPool *_pool;                ///< member simulation (NULL: sequential)
+    vector<double> _busy;           ///< busy time per member
+    uint64 _full_stripe;            ///< RAID-5 full-row writes
+    uint64 _rmw;                    ///< RAID-5 read-modify-write rows
+
+    vector<vector<SubRequest> > _sub; ///< scratch: sub-requests per member
+    vector<double> _cursor;         ///< scratch: member free again
+
+    /// @brief constructor (see create())
+    DiskArray(uint32 level, const vector<HDD*> &members, uint32 stripe,
+              uint32 nthreads);
+
+    /// @brief member and member block of logical block @a block
+    void locate(uint64 block, uint32 *member, uint64 *mblock) const;
+
+    /// @brief split a RAID-0/1 request into sub-requests (appended to _sub)
+    void split(uint32 req, const ArrayRequest &r);
+
+    /// @brief serve the sub-requests of member @a m in order
+    void serve(uint32 m);
+
+    /// @brief serve one request sequentially
+    /// @retval time when the request ends (negative if it failed)
+    double access(const ArrayRequest &r);
+
+    /// @brief serve a sub-request on member @a m, after its previous one
+    /// @param start earliest start
+    /// @retval time when it ends (negative if it failed)
+    double member_access(uint32 m, double start, uint64 block, uint64 nblocks,
+                         bool write);
+
+    /// @brief RAID-5 write of the part [@a block, @a block+@a nblocks) of row
+    ///        @a row
+    /// @retval time when the row is updated (negative if it failed)
+    double write_row(double ts, uint64 row, uint64 block, uint64 nblocks);
+
+  private:
+    DiskArray(const DiskArray&);
+    DiskArray& operator=(const DiskArray&);
+};
+
+#endif // __CA_ARRAY_H__
@@ -0,0 +1,433 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief microbenchmarks of the simulator hot paths
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <libgen.h>
+
+#include "cache.h"
+#include "hdd.h"
+#include "sweep.h"
+#include "trace.h"
+using namespace std;
+
+static const uint64 BENCH_OPS = 1 << 20;    ///< operations per repetition
+
+///@brief measurements of one benchmark
+typedef struct BenchResult {
+  string name;                      ///< benchmark name
+  const char *unit;                 ///< what an operation is
+  uint64 ops;                       ///< operations per repetition
+  vector<double> seconds;           ///< wall-clock time of every repetition
+  double hit_ratio;                 ///< measured hit ratio (< 0: n/a)
+} BenchResult;
+
+///@brief benchmark options
+typedef struct Options {
+  const char *cfg;                  ///< disk configuration
+  vector<const char*> traces;       ///< traces replayed end-to-end
+  uint32 repeat;                    ///< timed repetitions
+  uint32 warmup;                    ///< untimed repetitions before
+  const char *filter;               ///< run only names containing this
+  const char *json;                 ///< JSON output file (NULL: none)
+} Options;
+
+/// @brief HDD with the protected address translation exposed
+class BenchHDD : public HDD {
+  public:
+    using HDD::HDD;
+    using HDD::decode;
+};
+
+/// @brief print usage information. Does not return (exit with @retstat)
+static void help(char *program, int retstat)
+{
+  char *bn = basename(program);
+  cout << "Usage: " << bn << " [-c/--config <CONFIG FILE>] [-t/--trace "
+       << "<TRACE FILE>...]" << endl
+       << "         [-r/--repeat <N>] [-w/--warmup <N>] [--filter <NAME>] "
+       << "[--json <FILE>]" << endl
+       << endl
+       << "Time the simulator hot paths (address translation, seek time, "
+       << "disk reads," << endl
+       << "cache lookups) and end-to-end replay of the traces on the disk "
+       << "of CONFIG FILE" << endl
+       << "(default: config/hdd2.cfg, the bundled traces). Every benchmark "
+       << "runs N warmup" << endl
+       << "(default: 1) and N timed (default: 5) repetitions; --filter runs "
+       << "only the" << endl
+       << "benchmarks whose name contains NAME. --json writes the results "
+       << "to FILE." << endl
+       << endl;
+
+  exit(retstat);
+}
+
+/// @brief parse command line arguments
+static void parse_arguments(int argc, char *argv[], Options *opt)
+{
+  opt->cfg = "config/hdd2.cfg";
+  opt->repeat = 5;
+  opt->warmup = 1;
+  opt->filter = opt->json = NULL;
+
+  for (int i=1; i<argc; i++) {
+    bool more = i+1 < argc;
+    if ((strcmp(argv[i], "-c") == 0) || (strcmp(argv[i], "--config") == 0)) {
+      if (more) opt->cfg = argv[++i];
+    } else
+    if ((strcmp(argv[i], "-t") == 0) || (strcmp(argv[i], "--trace") == 0)) {
+      while ((i+1 < argc) && (argv[i+1][0] != '-')) {
+        opt->traces.push_back(argv[++i]);
+      }
+      more = !opt->traces.empty();
+    } else
+    if ((strcmp(argv[i], "-r") == 0) || (strcmp(argv[i], "--repeat") == 0)) {
+      if (more) opt->repeat = atoi(argv[++i]);
+      more = more && (opt->repeat > 0);
+    } else
+    if ((strcmp(argv[i], "-w") == 0) || (strcmp(argv[i], "--warmup") == 0)) {
+      if (more) opt->warmup = atoi(argv[++i]);
+    } else
+    if (strcmp(argv[i], "--filter") == 0) {
+      if (more) opt->filter = argv[++i];
+    } else
+    if (strcmp(argv[i], "--json") == 0) {
+      if (more) opt->json = argv[++i];
+    } else
+    if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+      help(argv[0], EXIT_SUCCESS);
+    } else {
+      cout << "Error: unknown option " << argv[i] << "." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+    if (!more) {
+      cout << "Error: missing or invalid argument for " << argv[i] << "."
+        << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+  }
+
+  if (opt->traces.empty()) {
+    const char *bundled[] = { "traces/test1.trace", "traces/vm.trace.bz2",
+                              "traces/vm.sequence1.bz2",
+                              "traces/vm.shuffle1.bz2" };
+    for (size_t i=0; i<sizeof(bundled)/sizeof(bundled[0]); i++) {
+      opt->traces.push_back(bundled[i]);
+    }
+  }
+}
+
+/// @brief create a disk with the parameters @a c
+/// @param cache_blocks cache size overriding the configuration file
+///        (negative: from the file; below 2 also turns off write-back)
+/// @retval disk
+static BenchHDD* create_disk(const HDD_Config &c, int cache_blocks=-1)
+{
+  HDD_Config d = c;
+  if (cache_blocks >= 0) {
+    d.cache_size = cache_blocks;
+    if (cache_blocks < 2) d.write_back = false;
+  }
+
+  BenchHDD *hdd = new BenchHDD(d.surfaces, d.tracks_per_surface,
+                               d.sectors_innermost, d.sectors_outermost,
+                               d.rpm, d.bytes_per_sector,
+                               d.seek_overhead, d.seek_per_track,
+                               d.cache_size, d.cache_policy.c_str(),
+                               false, true);
+  hdd->write_back(d.write_back, d.high_watermark);
+
+  return hdd;
+}
+
+/// @brief run @a body @a warmup times untimed, then @a repeat times timed
+/// @param body one repetition; returns a value that depends on the work so
+///        that it cannot be optimized away
+/// @param setup called untimed before every repetition (empty: none)
+static void measure(BenchResult &r, const Options &opt,
+                    function<uint64(void)> body, function<void(void)> setup)
+{
+  volatile uint64 sink = 0;
+
+  for (uint32 i=0; i<opt.warmup; i++) {
+    if (setup) setup();
+    sink = sink + body();
+  }
+  for (uint32 i=0; i<opt.repeat; i++) {
+    if (setup) setup();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    sink = sink + body();
+    r.seconds.push_back(chrono::duration<double>(chrono::steady_clock::now()
+                                                 - start).count());
+  }
+}
+
+/// @brief median of @a v
+static double median(vector<double> v)
+{
+  sort(v.begin(), v.end());
+  size_t n = v.size();
+  return n % 2 ? v[n/2] : (v[n/2-1] + v[n/2])/2;
+}
+
+/// @brief print one result line
+static void print_result(const BenchResult &r)
+{
+  double med = median(r.seconds);
+  double lo = *min_element(r.seconds.begin(), r.seconds.end());
+
+  cout << left << setw(34) << r.name << right << fixed << setprecision(1)
+       << setw(10) << lo/r.ops*1e9 << setw(10) << med/r.ops*1e9
+       << setw(14) << setprecision(0) << r.ops/med << " " << r.unit << "s/s";
+  if (r.hit_ratio >= 0) {
+    cout << setprecision(1) << " (hit ratio " << r.hit_ratio*100 << "%)";
+  }
+  cout << endl;
+}
+
+/// @brief quote @a s as a JSON string
+static string json_string(const string &s)
+{
+  string q = "\"";
+  for (size_t i=0; i<s.size(); i++) {
+    if ((s[i] == '"') || (s[i] == '\\')) q += '\\';
+    q += s[i];
+  }
+  return q + "\"";
+}
+
+/// @brief write all results to @a path
+static bool write_json(const char *path, const Options &opt,
+                       const vector<BenchResult> &res)
+{
+  ofstream out(path);
+  if (!out.good()) {
+    cout << "Cannot create JSON file '" << path << "'." << endl;
+    return false;
+  }
+
+  out << fixed << setprecision(3)
+      << "{" << endl
+      << "  \"config\": " << json_string(opt.cfg) << "," << endl
+      << "  \"repeat\": " << opt.repeat << "," << endl
+      << "  \"warmup\": " << opt.warmup << "," << endl
+      << "  \"benchmarks\": [" << endl;
+  for (size_t i=0; i<res.size(); i++) {
+    const BenchResult &r = res[i];
+    double med = median(r.seconds);
+    double lo = *min_element(r.seconds.begin(), r.seconds.end());
+    double hi = *max_element(r.seconds.begin(), r.seconds.end());
+
+    out << "    { \"name\": " << json_string(r.name)
+        << ", \"unit\": " << json_string(r.unit)
+        << ", \"ops\": " << r.ops
+        << ", \"ns_per_op\": { \"min\": " << lo/r.ops*1e9
+        << ", \"median\": " << med/r.ops*1e9
+        << ", \"max\": " << hi/r.ops*1e9 << " }"
+        << ", \"per_second\": " << r.ops/med;
+    if (r.hit_ratio >= 0) out << ", \"hit_ratio\": " << r.hit_ratio;
+    out << " }" << (i+1 < res.size() ? "," : "") << endl;
+  }
+  out << "  ]" << endl
+      << "}" << endl;
+
+  return out.good();
+}
+
+/// @brief program entry point
+int main(int argc, char *argv[])
+{
+  Options opt;
+  parse_arguments(argc, argv, &opt);
+
+  HDD_Config cfg;
+  if (!HDD::read_config(opt.cfg, NULL, &cfg)) return EXIT_FAILURE;
+
+  BenchHDD *probe = create_disk(cfg, 0);
+  uint64 blocks = probe->capacity() / probe->bytes_per_sector();
+  uint32 tracks = probe->tracks_per_surface();
+  delete probe;
+
+  vector<BenchResult> res;
+  mt19937_64 rng(42);
+
+  // run a benchmark unless it is filtered out; the hit ratio is measured
+  // if @a cache is given; @a setup runs untimed before every repetition
+  auto bench = [&](const string &name, const char *unit, uint64 ops,
+                   const BlockCache *cache, function<uint64(void)> body,
+                   function<void(void)> setup = nullptr) {
+    if ((opt.filter != NULL) && (name.find(opt.filter) == string::npos)) {
+      return;
+    }
+    BenchResult r = { name, unit, ops, vector<double>(), -1.0 };
+    measure(r, opt, body, setup);
+    if (cache != NULL) {
+      r.hit_ratio = (double)cache->hits() / (cache->hits() + cache->misses());
+    }
+    res.push_back(r);
+    print_result(r);
+  };
+
+  cout << "benchmarks on " << opt.cfg << " (" << opt.warmup << " warmup, "
+       << opt.repeat << " timed repetitions):" << endl
+       << left << setw(34) << "benchmark" << right << setw(10) << "min ns/op"
+       << setw(10) << "med ns/op" << setw(24) << "throughput (median)"
+       << endl;
+
+  //
+  // address translation and seek time on uniformly random blocks/tracks
+  //
+  BenchHDD *hdd = create_disk(cfg, 0);
+  vector<uint64> block(BENCH_OPS);
+  vector<uint32> track(BENCH_OPS);
+
+  // only blocks that decode() accepts; it reports the others on cout
+  streambuf *out = cout.rdbuf(NULL);
+  for (size_t i=0; i<BENCH_OPS; i++) {
+    HDD_Position pos;
+    do block[i] = rng() % blocks; while (!hdd->decode(block[i], &pos));
+    track[i] = rng() % tracks;
+  }
+  cout.rdbuf(out);
+  bench("hdd.decode", "op", BENCH_OPS, NULL, [&]() {
+    HDD_Position pos;
+    uint64 sum = 0;
+    for (size_t i=0; i<BENCH_OPS; i++) {
+      if (hdd->decode(block[i], &pos)) sum += pos.track;
+    }
+    return sum;
+  });
+
+  bench("hdd.seek_time", "op", BENCH_OPS, NULL, [&]() {
+    double sum = 0;
+    for (size_t i=1; i<BENCH_OPS; i++) {
+      sum += hdd->seek_time(track[i-1], track[i]);
+    }
+    return (uint64)sum;
+  });
+
+  //
+  // uncached reads of 1 block and of 1024 blocks (several tracks)
+  //
+  const uint64 nblocks[] = { 1, 1024 };
+  for (size_t n=0; n<2; n++) {
+    uint64 ops = BENCH_OPS >> (3*n);
+    bench("hdd.read/" + to_string(nblocks[n]) + " blocks", "request", ops, NULL,
+          [&, n, ops]() {
+      double sum = 0;
+      for (size_t i=0; i<ops; i++) {
+        sum += hdd->read(0, block[i], nblocks[n]);
+      }
+      return (uint64)sum;
+    });
+  }
+  delete hdd;
+
+  //
+  // cache lookups: a fraction h of the accesses go to a working set that
+  // fits into the cache, the rest to blocks that are never reused
+  //
+  const uint32 sizes[] = { 1024, 16384, 262144 };
+  const double ratios[] = { 0.5, 0.9, 0.99 };
+  for (size_t s=0; s<3; s++) {
+    for (size_t h=0; h<3; h++) {
+      uint32 size = sizes[s];
+      vector<uint64> stream(BENCH_OPS);
+      uint64 cold = size;
+      for (size_t i=0; i<BENCH_OPS; i++) {
+        bool hot = (double)(rng() >> 11) / (1ULL << 53) < ratios[h];
+        stream[i] = hot ? rng() % (size/2) : cold++;
+      }
+
+      BlockCache *cache = BlockCache::create("lru", size, false, true);
+      bench("cache.get/" + to_string(size) + "/" +
+            to_string((int)(ratios[h]*100)) + "%", "op", BENCH_OPS, cache,
+            [&]() {
+        uint64 hits = 0;
+        for (size_t i=0; i<BENCH_OPS; i++) hits += cache->get(stream[i]);
+        return hits;
+      });
+      delete cache;
+    }
+  }
+
+  //
+  // end-to-end replay on a fresh disk
+  //
+  for (size_t t=0; t<opt.traces.size(); t++) {
+    string name = string("replay/") + basename((char*)opt.traces[t]);
+    if ((opt.filter != NULL) && (name.find(opt.filter) == string::npos)) {
+      continue;
+    }
+
+    vector<TraceRequest> trace;
+    if (!load_trace(opt.traces[t], trace, 0) || trace.empty()) {
+      cout << left << setw(34) << name << "cannot read trace" << endl;
+      continue;
+    }
+
+    // a fresh disk for every repetition, created before the clock starts
+    BenchHDD *disk = NULL;
+    bench(name, "request", trace.size(), NULL, [&]() {
+      uint32 bps = disk->bytes_per_sector();
+      double sum = 0;
+      for (size_t i=0; i<trace.size(); i++) {
+        const TraceRequest &r = trace[i];
+        uint64 b = r.address / bps, n = (r.length + bps-1) / bps;
+        sum += r.rw == 'w' ? disk->write(r.ts, b, n) - r.ts
+                           : disk->read(r.ts, b, n) - r.ts;
+      }
+      return (uint64)sum;
+    }, [&]() {
+      delete disk;
+      disk = create_disk(cfg);
+    });
+    delete disk;
+  }
+  cout << endl;
+
+  if ((opt.json != NULL) && !write_json(opt.json, opt, res)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,513 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief bzip2-compressed text traces, decompressed on background threads
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <istream>
+
+#include <bzlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bz2trace.h"
+using namespace std;
+
+static const uint64 BLOCK_MAGIC = 0x314159265359ULL; ///< bzip2 block magic
+static const uint64 EOS_MAGIC   = 0x177245385090ULL; ///< end of stream magic
+static const uint64 MAGIC_MASK  = 0xffffffffffffULL; ///< 48 bits
+static const int    MAX_JOIN    = 8;       ///< max. blocks joined on retry
+static const size_t BATCH_SIZE  = 4096;    ///< requests per batch
+static const size_t QUEUE_SIZE  = 16;      ///< default max. batches in queue
+
+/// @brief read @a n <= 32 bits starting at bit @a pos (MSB first)
+static uint64 get_bits(const unsigned char *d, size_t size, uint64 pos, int n)
+{
+  size_t b = pos >> 3;
+  uint64 v = 0;
+
+  for (int i=0; i<8; i++) v = (v << 8) | (b+i < size ? d[b+i] : 0);
+  return (v << (pos & 7)) >> (64 - n);
+}
+
+/// @brief decompress the block in bits [@a start, @a end) of @a d by
+///        wrapping it into a single-block bzip2 stream
+/// @retval true on success
+static bool decode_block(const unsigned char *d, size_t size, uint64 start,
+                         uint64 end, char level, uint32 crc, string *out)
+{
+  //
+  // stream header, block bits, end of stream marker with the combined CRC
+  // (which equals the block CRC for a single block)
+  //
+  string in;
+  uint64 acc = 0;
+  int nacc = 0;
+
+  in.reserve((end - start)/8 + 16);
+  in.append("BZh");
+  in.push_back(level);
+
+  auto put = [&](uint64 v, int n) {
+    acc = (acc << n) | v;
+    nacc += n;
+    while (nacc >= 8) {
+      nacc -= 8;
+      in.push_back((char)(acc >> nacc));
+    }
+  };
+
+  for (uint64 p=start; p<end; p+=32) {
+    int n = (int)min<uint64>(32, end-p);
+    put(get_bits(d, size, p, n), n);
+  }
+  put(EOS_MAGIC >> 24, 24);
+  put(EOS_MAGIC & 0xffffff, 24);
+  put(crc, 32);
+  if (nacc > 0) put(0, 8-nacc);
+
+  //
+  // decompress
+  //
+  bz_stream s;
+  memset(&s, 0, sizeof(s));
+  if (BZ2_bzDecompressInit(&s, 0, 0) != BZ_OK) return false;
+
+  s.next_in = &in[0];
+  s.avail_in = in.size();
+  out->resize((level - '0') * 100000 + 4096);
+
+  size_t len = 0;
+  int ret;
+  do {
+    if (len == out->size()) out->resize(out->size()*2);
+    s.next_out = &(*out)[len];
+    s.avail_out = out->size() - len;
+    ret = BZ2_bzDecompress(&s);
+    len = out->size() - s.avail_out;
+  } while ((ret == BZ_OK) && ((s.avail_in > 0) || (s.avail_out == 0)));
+
+  BZ2_bzDecompressEnd(&s);
+  out->resize(len);
+
+  return ret == BZ_STREAM_END;
+}
+
+//------------------------------------------------------------------------------
+// Bz2Buffer
+//
+Bz2Buffer::Bz2Buffer(const unsigned char *data, size_t size, uint32 nthreads)
+  : _data(data), _size(size), _failed(false), _claim(0), _cur(0),
+    _window(max<size_t>(4, 2*nthreads)), _stop(false), _serial(true),
+    _strm(NULL), _in(0)
+{
+  setg(NULL, NULL, NULL);
+
+  if ((nthreads > 1) && split() && (_block.size() > 1)) {
+    _serial = false;
+    for (uint32 t=0; t<nthreads; t++) {
+      _worker.push_back(thread(&Bz2Buffer::work, this));
+    }
+  } else {
+    _block.clear();
+    bz_stream *s = new bz_stream;
+    memset(s, 0, sizeof(*s));
+    if (BZ2_bzDecompressInit(s, 0, 0) != BZ_OK) {
+      delete s;
+      _failed = true;
+    } else {
+      _strm = s;
+      _buf.resize(1 << 20);
+    }
+  }
+}
+
+Bz2Buffer::~Bz2Buffer(void)
+{
+  {
+    lock_guard<mutex> l(_lock);
+    _stop = true;
+  }
+  _cv.notify_all();
+  for (size_t t=0; t<_worker.size(); t++) _worker[t].join();
+
+  if (_strm != NULL) {
+    BZ2_bzDecompressEnd((bz_stream*)_strm);
+    delete (bz_stream*)_strm;
+  }
+}
+
+bool Bz2Buffer::failed(void) const
+{
+  return _failed;
+}
+
+bool Bz2Buffer::split(void)
+{
+  uint64 nbits = (uint64)_size*8, pos = 0;
+
+  while (pos < nbits) {
+    //
+    // stream header "BZh1".."BZh9" (byte-aligned)
+    //
+    size_t b = pos / 8;
+    if ((_size - b < 4) || (memcmp(_data+b, "BZh", 3) != 0) ||
+        (_data[b+3] < '1') || (_data[b+3] > '9')) {
+      return false;
+    }
+    char level = _data[b+3];
+    pos += 32;
+
+    //
+    // blocks up to the end of stream marker
+    //
+    size_t first = _block.size();
+    uint64 w = 0, p = pos;
+    bool eos = false;
+
+    while ((p < nbits) && !eos) {
+      w = ((w << 1) | ((_data[p >> 3] >> (7 - (p & 7))) & 1)) & MAGIC_MASK;
+      p++;
+      if (p - pos < 48) continue;
+
+      if ((w == BLOCK_MAGIC) || (w == EOS_MAGIC)) {
+        if (_block.size() > first) _block.back().end = p - 48;
+        if (w == EOS_MAGIC) {
+          eos = true;
+        } else {
+          if (p + 32 > nbits) return false;
+          Block nb;
+          nb.start = p - 48;
+          nb.end = 0;
+          nb.level = level;
+          nb.crc = get_bits(_data, _size, p, 32);
+          nb.state = BLOCK_PENDING;
+          _block.push_back(nb);
+        }
+      }
+    }
+    if (!eos) return false;
+
+    // skip the stream CRC and padding
+    pos = (p + 32 + 7) & ~7ULL;
+  }
+
+  return true;
+}
+
+void Bz2Buffer::decompress(size_t k)
+{
+  const Block &b = _block[k];
+  uint64 end = b.end;
+  size_t next = k+1;
+  string out;
+  bool ok;
+
+  //
+  // a block magic may also occur inside compressed data. If the block is
+  // corrupt, retry with following blocks of the same stream joined to it
+  //
+  while (!(ok = decode_block(_data, _size, b.start, end, b.level, b.crc, &out))
+         && (next - k <= MAX_JOIN) && (next < _block.size())
+         && (_block[next].start == end)) {
+    end = _block[next++].end;
+  }
+
+  lock_guard<mutex> l(_lock);
+  if (_block[k].state == BLOCK_PENDING) {
+    _block[k].state = ok ? BLOCK_DONE : BLOCK_FAILED;
+    _block[k].out.swap(out);
+    if (ok) {
+      for (size_t j=k+1; j<next; j++) {
+        _block[j].state = BLOCK_SKIPPED;
+        string().swap(_block[j].out);
+      }
+    }
+  }
+  _cv.notify_all();
+}
+
+void Bz2Buffer::work(void)
+{
+  unique_lock<mutex> l(_lock);
+
+  while (true) {
+    _cv.wait(l, [this] {
+      return _stop || (_claim >= _block.size()) || (_claim < _cur + _window);
+    });
+    if (_stop || (_claim >= _block.size())) return;
+
+    size_t k = _claim++;
+    if (_block[k].state != BLOCK_PENDING) continue;
+
+    l.unlock();
+    decompress(k);
+    l.lock();
+  }
+}
+
+Bz2Buffer::int_type Bz2Buffer::underflow(void)
+{
+  if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+  if (_serial) return underflow_serial();
+
+  unique_lock<mutex> l(_lock);
+
+  // release the block consumed last
+  if (_cur > 0) string().swap(_block[_cur-1].out);
+  setg(NULL, NULL, NULL);
+
+  while (_cur < _block.size()) {
+    Block &b = _block[_cur];
+    _cv.wait(l, [&b] { return b.state != BLOCK_PENDING; });
+    _cur++;
+    _cv.notify_all();
+
+    if (b.state == BLOCK_FAILED) {
+      _failed = true;
+      return traits_type::eof();
+    }
+    if ((b.state == BLOCK_DONE) && !b.out.empty()) {
+      char *p = &b.out[0];
+      setg(p, p, p + b.out.size());
+      return traits_type::to_int_type(*p);
+    }
+  }
+
+  return traits_type::eof();
+}
+
+Bz2Buffer::int_type Bz2Buffer::underflow_serial(void)
+{
+  bz_stream *s = (bz_stream*)_strm;
+
+  while (s != NULL) {
+    if ((s->avail_in == 0) && (_in < _size)) {
+      s->next_in = (char*)_data + _in;
+      s->avail_in = min<size_t>(_size - _in, 1 << 30);
+      _in += s->avail_in;
+    }
+    s->next_out = &_buf[0];
+    s->avail_out = _buf.size();
+
+    int ret = BZ2_bzDecompress(s);
+    size_t n = _buf.size() - s->avail_out;
+    bool end = false;
+
+    if (ret == BZ_STREAM_END) {
+      //
+      // continue with the next stream of a concatenated file, if any
+      //
+      size_t left = s->avail_in + (_size - _in);
+      size_t at = _size - left;
+      BZ2_bzDecompressEnd(s);
+      memset(s, 0, sizeof(*s));
+      if ((left >= 4) && (memcmp(_data+at, "BZh", 3) == 0) &&
+          (BZ2_bzDecompressInit(s, 0, 0) == BZ_OK)) {
+        s->next_in = (char*)_data + at;
+        s->avail_in = min<size_t>(left, 1 << 30);
+        _in = at + s->avail_in;
+      } else {
+        end = true;
+      }
+    } else
+    if ((ret != BZ_OK) || ((n == 0) && (s->avail_in == 0) && (_in == _size))) {
+      // corrupt or truncated
+      _failed = true;
+      end = true;
+    }
+
+    if (end) {
+      if (ret != BZ_STREAM_END) BZ2_bzDecompressEnd(s);
+      delete s;
+      _strm = s = NULL;
+    }
+
+    if (n > 0) {
+      setg(&_buf[0], &_buf[0], &_buf[0] + n);
+      return traits_type::to_int_type(_buf[0]);
+    }
+  }
+
+  return traits_type::eof();
+}
+
+//------------------------------------------------------------------------------
+// Bz2TraceReader
+//
+Bz2TraceReader::Bz2TraceReader(const char *path, uint32 nthreads,
+                               uint32 queue)
+  : _map(NULL), _size(0), _nthreads(nthreads),
+    _queue(queue > 0 ? queue : QUEUE_SIZE), _done(false), _corrupt(false),
+    _failed(false), _stop(false), _batch(NULL), _pos(0)
+{
+  _comment[0] = '\0';
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+    void *m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m != MAP_FAILED) {
+      _map = (const unsigned char*)m;
+      _size = st.st_size;
+      madvise(m, _size, MADV_SEQUENTIAL);
+    }
+  }
+  ::close(fd);
+
+  if (_map != NULL) _producer = thread(&Bz2TraceReader::produce, this);
+}
+
+Bz2TraceReader::~Bz2TraceReader(void)
+{
+  {
+    lock_guard<mutex> l(_lock);
+    _stop = true;
+  }
+  _cv.notify_all();
+  if (_producer.joinable()) _producer.join();
+
+  delete _batch;
+  for (size_t i=0; i<_full.size(); i++) delete _full[i];
+  for (size_t i=0; i<_free.size(); i++) delete _free[i];
+
+  if (_map != NULL) munmap((void*)_map, _size);
+}
+
+bool Bz2TraceReader::is_bz2(const char *path)
+{
+  char magic[4];
+  ifstream in(path, ios::binary);
+
+  return in.read(magic, 4) && (memcmp(magic, "BZh", 3) == 0) &&
+         (magic[3] >= '1') && (magic[3] <= '9');
+}
+
+bool Bz2TraceReader::valid(void) const
+{
+  return _map != NULL;
+}
+
+void Bz2TraceReader::produce(void)
+{
+  Bz2Buffer buf(_map, _size, _nthreads);
+  TextTraceReader text(new istream(&buf));
+  TraceRequest r;
+  bool more = true;
+
+  while (more) {
+    Batch *b;
+    {
+      lock_guard<mutex> l(_lock);
+      if (_free.empty()) {
+        b = new Batch;
+      } else {
+        b = _free.back();
+        _free.pop_back();
+      }
+    }
+    b->req.clear();
+    b->cmt.clear();
+    b->text.clear();
+
+    while ((b->req.size() < BATCH_SIZE) && (more = text.next(&r))) {
+      b->req.push_back(r);
+      b->cmt.push_back(b->text.size());
+      b->text.append(text.comment());
+    }
+    b->cmt.push_back(b->text.size());
+
+    unique_lock<mutex> l(_lock);
+    _cv.wait(l, [this] { return _stop || (_full.size() < _queue); });
+    if (_stop || b->req.empty()) {
+      _free.push_back(b);
+      if (_stop) break;
+    } else {
+      _full.push_back(b);
+      _cv.notify_all();
+    }
+  }
+
+  lock_guard<mutex> l(_lock);
+  _corrupt = buf.failed();
+  _failed = _corrupt || text.failed();
+  _done = true;
+  _cv.notify_all();
+}
+
+bool Bz2TraceReader::next(TraceRequest *r)
+{
+  while ((_batch == NULL) || (_pos == _batch->req.size())) {
+    unique_lock<mutex> l(_lock);
+    if (_batch != NULL) {
+      _free.push_back(_batch);
+      _batch = NULL;
+    }
+    _cv.wait(l, [this] { return !_full.empty() || _done; });
+
+    if (_full.empty()) {
+      if (_corrupt) {
+        cout << "Error: corrupt bzip2 trace." << endl;
+        _corrupt = false;
+      }
+      return false;
+    }
+    _batch = _full.front();
+    _full.pop_front();
+    _pos = 0;
+    _cv.notify_all();
+  }
+
+  size_t i = _pos++;
+  size_t n = min<size_t>(_batch->cmt[i+1] - _batch->cmt[i], CMT_SIZE-1);
+
+  *r = _batch->req[i];
+  memcpy(_comment, _batch->text.data() + _batch->cmt[i], n);
+  _comment[n] = '\0';
+
+  return true;
+}
+
+char* Bz2TraceReader::comment(void)
+{
+  return _comment;
+}
+
+bool Bz2TraceReader::failed(void) const
+{
+  // set by the producer before _done, which next() has seen under the lock
+  return _failed;
+}
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief bzip2-compressed text traces, decompressed on background threads
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_BZ2TRACE_H__
+#define __CA_BZ2TRACE_H__
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "types.h"
+#include "trace.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief decompressed contents of an in-memory .bz2 file as a stream buffer
+///
+/// With more than one thread, the compressed data is split at the bzip2 block
+/// magic (blocks are not byte-aligned, so the split is done at bit
+/// granularity) and every block is re-wrapped into a single-block stream and
+/// decompressed independently by a pool of worker threads. Blocks are handed
+/// out in order and at most a bounded window of blocks is decompressed ahead
+/// of the reader. With one thread, or if the file cannot be split, the data
+/// is decompressed sequentially by libbz2.
+///
+class Bz2Buffer : public streambuf {
+  public:
+    /// @brief constructor
+    /// @param data compressed data (must stay valid during the lifetime)
+    /// @param size size of @a data in bytes
+    /// @param nthreads number of decompression threads
+    Bz2Buffer(const unsigned char *data, size_t size, uint32 nthreads);
+
+    /// @brief destructor
+    virtual ~Bz2Buffer(void);
+
+    /// @brief true if the compressed data is corrupt
+    bool failed(void) const;
+
+  protected:
+    /// @brief refill the get area with the next decompressed data
+    virtual int_type underflow(void);
+
+  private:
+    ///@brief a bzip2 block in the compressed data
+    typedef struct {
+      uint64 start;                 ///< bit offset of the block magic
+      uint64 end;                   ///< bit offset of the next magic
+      char   level;                 ///< block size level of the stream
+      uint32 crc;                   ///< block CRC
+      int    state;                 ///< one of the BLOCK_* states below
+      string out;                   ///< decompressed data
+    } Block;
+
+    enum { BLOCK_PENDING, BLOCK_DONE, BLOCK_FAILED, BLOCK_SKIPPED };
+
+    const unsigned char *_data;     ///< compressed data
+    size_t _size;                   ///< size of compressed data
+    bool   _failed;                 ///< data is corrupt
+
+    // parallel decompression
+    vector<Block> _block;           ///< blocks of the file
+    vector<thread> _worker;         ///< decompression threads
+    size_t _claim;                  ///< next block to decompress
+    size_t _cur;                    ///< next block to hand to the reader
+    size_t _window;                 ///< max. blocks decompressed ahead
+    bool   _stop;                   ///< workers shall terminate
+    mutex  _lock;                   ///< protects the block states
+    condition_variable _cv;         ///< block state changed
+
+    // sequential decompression
+    bool   _serial;                 ///< sequential mode
+    void  *_strm;                   ///< bz_stream (NULL: at end of data)
+    size_t _in;                     ///< bytes of input consumed
+    vector<char> _buf;              ///< output buffer
+
+    /// @brief split the data into blocks
+    /// @retval true if the data consists of well-formed bzip2 streams
+    bool split(void);
+
+    /// @brief decompress block @a k, joining it with following blocks if
+    ///        the block magic was a false positive inside compressed data
+    void decompress(size_t k);
+
+    /// @brief worker thread
+    void work(void);
+
+    /// @brief sequential decompression: refill _buf
+    int_type underflow_serial(void);
+};
+
+//------------------------------------------------------------------------------
+/// @brief reader for bzip2-compressed text traces
+///
+/// Decompression and parsing run on a producer thread that fills a bounded
+/// queue of parsed requests; next() consumes from this queue, so the
+/// simulation overlaps with decompression. A batch holds 4096 requests; the
+/// queue holds 16 batches unless the reader is opened with a shorter one.
+///
+class Bz2TraceReader : public TraceReader {
+  public:
+    /// @brief constructor; check valid() before use
+    /// @param path path to .bz2 trace
+    /// @param nthreads number of decompression threads
+    /// @param queue max. batches of parsed requests buffered ahead
+    ///        (0: default)
+    Bz2TraceReader(const char *path, uint32 nthreads, uint32 queue=0);
+
+    /// @brief destructor
+    virtual ~Bz2TraceReader(void);
+
+    /// @brief check whether @a path starts with the bzip2 magic
+    static bool is_bz2(const char *path);
+
+    /// @brief true if the file could be mapped
+    bool valid(void) const;
+
+    virtual bool next(TraceRequest *r);
+    virtual char* comment(void);
+    virtual bool failed(void) const;
+
+  protected:
+    ///@brief batch of parsed requests
+    typedef struct {
+      vector<TraceRequest> req;     ///< requests
+      vector<size_t> cmt;           ///< start of comment i in text (+1 end)
+      string text;                  ///< comments
+    } Batch;
+
+    const unsigned char *_map;      ///< mapped file
+    size_t _size;                   ///< size of mapping
+    uint32 _nthreads;               ///< decompression threads
+    size_t _queue;                  ///< max. batches in _full
+    thread _producer;               ///< decompress & parse thread
+
+    deque<Batch*> _full;            ///< parsed batches
+    vector<Batch*> _free;           ///< recycled batches
+    bool   _done;                   ///< producer has finished
+    bool   _corrupt;                ///< decompression failed (not reported)
+    bool   _failed;                 ///< decompression or parsing failed
+    bool   _stop;                   ///< producer shall terminate
+    mutex  _lock;                   ///< protects the queues
+    condition_variable _cv;         ///< queue state changed
+
+    Batch *_batch;                  ///< batch being consumed
+    size_t _pos;                    ///< next request in _batch
+    char _comment[CMT_SIZE];        ///< comment of last request
+
+    /// @brief producer thread
+    void produce(void);
+};
+
+#endif // __CA_BZ2TRACE_H__
@@ -36,35 +36,205 @@
 #include <cmath>
 #include <cstdlib>
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <string.h>
 
 #include "cache.h"
+#include "cache_policy.h"
 using namespace std;
 
+//------------------------------------------------------------------------------
+// BlockRuns
+//
+uint64 BlockRuns::insert(uint64 block, uint64 nblocks)
+{
+  uint64 first = block, end = block + nblocks, old = 0;
+
+  //
+  // merge with the overlapping or adjacent runs
+  //
+  map<uint64, uint64>::iterator it = _run.upper_bound(first);
+  if (it != _run.begin()) {
+    map<uint64, uint64>::iterator prev = it; prev--;
+    if (prev->second >= first) {
+      first = prev->first;
+      end = max(end, prev->second);
+      old += prev->second - prev->first;
+      _run.erase(prev);
+    }
+  }
+  while ((it != _run.end()) && (it->first <= end)) {
+    end = max(end, it->second);
+    old += it->second - it->first;
+    it = _run.erase(it);
+  }
+
+  _run.insert(it, make_pair(first, end));
+  _size += end - first - old;
+
+  return end - first - old;
+}
+
+uint64 BlockRuns::erase(uint64 block, uint64 nblocks,
+                        vector<pair<uint64, uint64> > *removed)
+{
+  uint64 end = block + nblocks, n = 0;
+
+  map<uint64, uint64>::iterator it = _run.upper_bound(block);
+  if (it != _run.begin()) {
+    it--;
+    if (it->second <= block) it++;
+  }
+
+  //
+  // cut [block, end) out of every overlapping run
+  //
+  while ((it != _run.end()) && (it->first < end)) {
+    uint64 rfirst = it->first, rend = it->second;
+    uint64 from = max(rfirst, block), to = min(rend, end);
+
+    n += to - from;
+    if (removed != NULL) removed->push_back(make_pair(from, to));
+
+    it = _run.erase(it);
+    if (rfirst < from) _run.insert(make_pair(rfirst, from));
+    if (to < rend) _run.insert(it, make_pair(to, rend));
+  }
+  _size -= n;
+
+  return n;
+}
+
+uint64 BlockRuns::take(uint64 block, uint64 limit)
+{
+  map<uint64, uint64>::iterator it = _run.upper_bound(block);
+  if (it == _run.begin()) return 0;
+  it--;
+  if (it->second <= block) return 0;
+
+  return erase(block, min(limit, it->second - block));
+}
+
+bool BlockRuns::next(uint64 from, uint64 *block) const
+{
+  if (_run.empty()) return false;
+
+  map<uint64, uint64>::const_iterator it = _run.upper_bound(from);
+  if (it != _run.begin()) {
+    map<uint64, uint64>::const_iterator prev = it; prev--;
+    if (prev->second > from) {
+      *block = from;
+      return true;
+    }
+  }
+  if (it == _run.end()) it = _run.begin();
+  *block = it->first;
+
+  return true;
+}
+
+uint64 BlockRuns::size(void) const
+{
+  return _size;
+}
+
+void BlockRuns::save(CheckpointWriter &out) const
+{
+  uint64 n = _run.size();
+  out.put(n);
+  for (map<uint64, uint64>::const_iterator it=_run.begin(); it!=_run.end();
+       it++) {
+    out.put(it->first);
+    out.put(it->second);
+  }
+}
+
+bool BlockRuns::restore(CheckpointReader &in)
+{
+  uint64 n, first, end;
+
+  _run.clear();
+  _size = 0;
+  if (!in.get(n)) return false;
+  for (uint64 i=0; i<n; i++) {
+    if (!in.get(first) || !in.get(end)) return false;
+    if ((end <= first) || (!_run.empty() && (first < _run.rbegin()->second))) {
+      return in.fail("corrupt block runs");
+    }
+    _run.insert(_run.end(), make_pair(first, end));
+    _size += end - first;
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // BlockCache
 //
-BlockCache::BlockCache(uint32 nblocks, bool verbose)
-  : _nblocks(nblocks), _verbose(verbose)
+BlockCache::BlockCache(uint32 nblocks, const char *policy, bool verbose,
+                       bool quiet)
+  : _nblocks(nblocks), _policy(policy), _verbose(verbose)
 {
   assert(nblocks >= 2);
+  assert(nblocks < CACHE_NIL/2);
 
   _hit = _miss = 0;
 
-  // TODO
-
   //
   // print info
   //
+  if (quiet) return;
   cout << "BlockCache: " << endl << dec
        << "  # cache blocks:              " << _nblocks << endl
+       << "  replacement policy:          " << _policy << endl
        << endl;
 }
 
 BlockCache::~BlockCache(void)
 {
-  // TODO
+}
+
+BlockCache* BlockCache::create(const char *policy, uint32 nblocks,
+                               bool verbose, bool quiet)
+{
+  if (strcmp(policy, LRUPolicy::name()) == 0)
+    return new LRUCache(nblocks, verbose, quiet);
+  if (strcmp(policy, ClockPolicy::name()) == 0)
+    return new ClockCache(nblocks, verbose, quiet);
+  if (strcmp(policy, TwoQPolicy::name()) == 0)
+    return new TwoQCache(nblocks, verbose, quiet);
+  if (strcmp(policy, ARCPolicy::name()) == 0)
+    return new ARCCache(nblocks, verbose, quiet);
+  if (strcmp(policy, LIRSPolicy::name()) == 0)
+    return new LIRSCache(nblocks, verbose, quiet);
+  if (strcmp(policy, SetAssocPolicy<4>::name()) == 0)
+    return new SA4Cache(nblocks, verbose, quiet);
+  if (strcmp(policy, SetAssocPolicy<8>::name()) == 0)
+    return new SA8Cache(nblocks, verbose, quiet);
+  if (strcmp(policy, SetAssocPolicy<16>::name()) == 0)
+    return new SA16Cache(nblocks, verbose, quiet);
+
+  return NULL;
+}
+
+bool BlockCache::is_policy(const char *policy)
+{
+  return (strcmp(policy, LRUPolicy::name()) == 0) ||
+         (strcmp(policy, ClockPolicy::name()) == 0) ||
+         (strcmp(policy, TwoQPolicy::name()) == 0) ||
+         (strcmp(policy, ARCPolicy::name()) == 0) ||
+         (strcmp(policy, LIRSPolicy::name()) == 0) ||
+         (ways(policy) > 0);
+}
+
+uint32 BlockCache::ways(const char *policy)
+{
+  if (strcmp(policy, SetAssocPolicy<4>::name()) == 0) return 4;
+  if (strcmp(policy, SetAssocPolicy<8>::name()) == 0) return 8;
+  if (strcmp(policy, SetAssocPolicy<16>::name()) == 0) return 16;
+  return 0;
 }
 
 uint32 BlockCache::size(void) const
@@ -72,45 +242,78 @@ uint32 BlockCache::size(void) const
   return _nblocks;
 }
 
-uint32 BlockCache::hits(void) const
+const char* BlockCache::policy(void) const
+{
+  return _policy;
+}
+
+uint64 BlockCache::hits(void) const
 {
   return _hit;
 }
 
-uint32 BlockCache::misses(void) const
+uint64 BlockCache::misses(void) const
 {
   return _miss;
 }
 
 float BlockCache::miss_rate(void) const
 {
-  // TODO
-  return 0.0;
+  uint64 accesses = _hit + _miss;
+
+  if (accesses == 0) return 0.0;
+  return (float)((double)_miss / (double)accesses);
 }
 
-void BlockCache::dump(void) const
+void BlockCache::mark_dirty(uint64 block, uint64 nblocks)
 {
-  cout.precision(3);
-  cout << "BlockCache::dump()" << endl << dec
-       << "  #hit/miss:  " << _hit << " / " << _miss << endl
-       << "  miss rate:  " << miss_rate()*100 << "%" << endl;
-  // TODO: dump contents of cache
+  _dirty.insert(block, nblocks);
+}
+
+uint64 BlockCache::dirty(void) const
+{
+  return _dirty.size();
+}
+
+bool BlockCache::next_dirty(uint64 from, uint64 *block) const
+{
+  return _dirty.next(from, block);
 }
 
-bool BlockCache::has(uint64 block) const
+uint64 BlockCache::clean(uint64 block, uint64 limit)
 {
-  // TODO
-  return false;
+  return _dirty.take(block, limit);
 }
 
-bool BlockCache::get(uint64 block)
+void BlockCache::save(CheckpointWriter &out) const
 {
-  // TODO
-  return false;
+  out.section("CACH");
+  out.put_string(_policy);
+  out.put(_nblocks);
+  out.put(_hit);
+  out.put(_miss);
+  _dirty.save(out);
 }
 
-void BlockCache::put(uint64 block)
+bool BlockCache::restore(CheckpointReader &in)
 {
-  // TODO
+  string policy;
+  uint32 nblocks;
+
+  if (!in.section("CACH") || !in.get_string(policy) || !in.get(nblocks)) {
+    return false;
+  }
+  if ((policy != _policy) || (nblocks != _nblocks)) {
+    return in.fail("the cache policy or size differs");
+  }
+
+  return in.get(_hit) && in.get(_miss) && _dirty.restore(in);
 }
 
+void BlockCache::dump(void) const
+{
+  cout.precision(3);
+  cout << "BlockCache::dump()" << endl << dec
+       << "  #hit/miss:  " << _hit << " / " << _miss << endl
+       << "  miss rate:  " << miss_rate()*100 << "%" << endl;
+}
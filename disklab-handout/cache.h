@@ -34,12 +34,77 @@
 #ifndef __CA_CACHE_H__
 #define __CA_CACHE_H__
 
+#include <map>
+#include <vector>
+
 #include "types.h"
+#include "checkpoint.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief set of blocks kept as disjoint runs of consecutive blocks
+///
+/// Adding or removing a run costs O(log runs) regardless of its length.
+///
+class BlockRuns {
+  public:
+    /// @brief constructor
+    BlockRuns(void) : _size(0) {};
+
+    /// @brief add blocks @a block to @a block+@a nblocks-1
+    /// @retval number of blocks that were not in the set
+    uint64 insert(uint64 block, uint64 nblocks);
+
+    /// @brief remove blocks @a block to @a block+@a nblocks-1
+    /// @param block first block
+    /// @param nblocks number of blocks
+    /// @param removed (output, optional) removed runs as [first, last+1)
+    /// @retval number of blocks removed
+    uint64 erase(uint64 block, uint64 nblocks,
+                 vector<pair<uint64, uint64> > *removed=NULL);
+
+    /// @brief remove the run of consecutive blocks starting at @a block
+    /// @param block first block of the run
+    /// @param limit maximal length of the run
+    /// @retval number of blocks removed
+    uint64 take(uint64 block, uint64 limit);
+
+    /// @brief find the first block at or after @a from, wrapping around to
+    ///        the lowest block
+    /// @retval false if the set is empty
+    bool next(uint64 from, uint64 *block) const;
+
+    /// @brief number of blocks in the set
+    uint64 size(void) const;
+
+    /// @brief write the runs to checkpoint @a out
+    void save(CheckpointWriter &out) const;
+
+    /// @brief replace the runs with those read from checkpoint @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    map<uint64, uint64> _run;       ///< runs: first -> last+1
+    uint64 _size;                   ///< number of blocks
+};
 
 //------------------------------------------------------------------------------
 /// @brief cache for rotating disk-based storage devices (HDD)
 ///
-/// The BlockCache class implements a simple fully-associative cache
+/// BlockCache is the interface of the disk caches. The
+/// replacement policies are implemented in cache_policy.h; the concrete
+/// caches are instances of the PolicyCache template, so the per-block access
+/// path is resolved at compile time. Callers that go through the BlockCache
+/// interface should use get_range()/put_range() to pay for one virtual call
+/// per request instead of one per block.
+///
+/// Use BlockCache::create() to instantiate a cache by policy name.
+///
+/// For write-back operation, the cache also keeps the set of dirty blocks,
+/// i.e., blocks written by the host but not yet written to the disk. Dirty
+/// blocks are held until they are destaged with clean(), independently of
+/// the replacement policy.
 ///
 class BlockCache {
   public:
@@ -48,13 +113,34 @@ class BlockCache {
 
     /// @brief constructor
     /// @param nblocks number of cache blocks (MUST BE >= 2!)
+    /// @param policy name of the replacement policy
     /// @param verbose verbose output
+    /// @param quiet do not print the cache parameters
     BlockCache(uint32 nblocks,
-               bool verbose=false);
+               const char *policy,
+               bool verbose=false,
+               bool quiet=false);
 
     /// @brief destructor
     virtual ~BlockCache(void);
 
+    /// @brief create a cache with replacement policy @a policy
+    /// @param policy policy name (lru, clock, 2q, arc, lirs; sa4, sa8, sa16
+    ///        for the set-associative caches)
+    /// @param nblocks number of cache blocks (MUST BE >= 2!)
+    /// @param verbose verbose output
+    /// @param quiet do not print the cache parameters
+    /// @retval BlockCache instance or NULL if @a policy is unknown
+    static BlockCache* create(const char *policy, uint32 nblocks,
+                              bool verbose=false, bool quiet=false);
+
+    /// @brief check whether @a policy names a supported replacement policy
+    static bool is_policy(const char *policy);
+
+    /// @brief associativity of a set-associative policy (sa4, sa8, sa16)
+    /// @retval number of ways or 0 if @a policy is fully associative
+    static uint32 ways(const char *policy);
+
     /// @}
     //
 
@@ -65,17 +151,20 @@ class BlockCache {
     /// @brief retrieve number of cache blocks
     uint32 size(void) const;
 
+    /// @brief retrieve the name of the replacement policy
+    const char* policy(void) const;
+
     /// @brief retrieve number of cache hits
-    uint32 hits(void) const;
+    uint64 hits(void) const;
 
     /// @brief retrieve number of cache misses
-    uint32 misses(void) const;
+    uint64 misses(void) const;
 
     /// @brief retrieve the miss rate
     float miss_rate(void) const;
 
     /// @brief dump cache contents to stdout
-    void dump(void) const;
+    virtual void dump(void) const;
 
     /// @}
 
@@ -87,7 +176,7 @@ class BlockCache {
     /// @param block block number
     /// @retval true block exists in cache (cache hit)
     /// @retval false block not cached (cache miss)
-    bool has(uint64 block) const;
+    virtual bool has(uint64 block) const = 0;
 
     /// @brief retrieve a block from the cache. If the block is
     ///        already cached, the block's access timestamp is
@@ -96,29 +185,75 @@ class BlockCache {
     /// @param block block number
     /// @retval true block exists in cache (cache hit)
     /// @retval false block not cached (cache miss)
-    bool get(uint64 block);
+    virtual bool get(uint64 block) = 0;
 
     /// @brief encache a block. If the block is already cached,
     ///        this function updates the block's access timestamp.
+    ///        Does not count as a hit or miss.
     /// @param block block number
-    /// @retval true cache hit
-    /// @retval false cache miss
-    void put(uint64 block);
+    virtual void put(uint64 block) = 0;
+
+    /// @brief get() blocks @a block to @a block+@a nblocks-1; costs one
+    ///        policy access per block
+    /// @retval number of misses
+    virtual uint64 get_range(uint64 block, uint64 nblocks) = 0;
+
+    /// @brief put() blocks @a block to @a block+@a nblocks-1; costs one
+    ///        policy access per block, except under LRU, which only inserts
+    ///        the blocks it keeps
+    virtual void put_range(uint64 block, uint64 nblocks) = 0;
+
+    /// @}
+
+
+    /// @name dirty blocks (write-back)
+    /// @{
+
+    /// @brief mark blocks @a block to @a block+@a nblocks-1 dirty
+    void mark_dirty(uint64 block, uint64 nblocks);
+
+    /// @brief retrieve the number of dirty blocks
+    uint64 dirty(void) const;
+
+    /// @brief find the first dirty block at or after @a from, wrapping around
+    ///        to the lowest dirty block
+    /// @param from block number to start from
+    /// @param block (output) dirty block
+    /// @retval false if no block is dirty
+    bool next_dirty(uint64 from, uint64 *block) const;
+
+    /// @brief clean the run of consecutive dirty blocks starting at @a block
+    /// @param block first block of the run (must be dirty)
+    /// @param limit maximal length of the run
+    /// @retval number of blocks cleaned
+    uint64 clean(uint64 block, uint64 limit);
+
+    /// @}
+
+
+    /// @name checkpoints
+    /// @{
+
+    /// @brief write the cache contents, recency order and counters to
+    ///        checkpoint @a out (section "CACH")
+    virtual void save(CheckpointWriter &out) const;
+
+    /// @brief read the state saved by save() from checkpoint @a in. The
+    ///        policy and size of the cache must be those of the saved cache.
+    /// @retval true on success
+    virtual bool restore(CheckpointReader &in);
 
     /// @}
 
 
   protected:
     uint32 _nblocks;                ///< number of blocks in cache
+    const char *_policy;            ///< name of replacement policy
     bool   _verbose;                ///< toggle verbose output
 
-    uint32 _hit;                    ///< number of cache hits
-    uint32 _miss;                   ///< number of cache misses
-
-    // TODO add more fields as necessary
-
-    // TODO
-    // add more methods as necessary
+    uint64 _hit;                    ///< number of cache hits
+    uint64 _miss;                   ///< number of cache misses
+    BlockRuns _dirty;               ///< dirty blocks
 };
 
 #endif // __CA_CACHE_H__
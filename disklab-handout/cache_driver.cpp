@@ -42,12 +42,13 @@
 #include "cache.h"
 using namespace std;
 
-void test(int size, bool debug)
+void test(int size, const char *policy, bool debug)
 {
   cout << "-----------------------------------------------------------" << endl;
 
   int i, j;
-  BlockCache bc(size, true);
+  BlockCache *cache = BlockCache::create(policy, size, true);
+  BlockCache &bc = *cache;
 
   if (debug) bc.dump();
 
@@ -88,6 +89,8 @@ void test(int size, bool debug)
   if (!debug) bc.dump();
 
   cout << endl << endl;
+
+  delete cache;
 }
 
 /// @brief program entry point
@@ -99,9 +102,18 @@ int main(int argc, char *argv[])
   //
   bool debug = true;
 
-  test(2, debug);
-  test(7, debug);
-  test(16, debug);
+  test(2, "lru", debug);
+  test(7, "lru", debug);
+  test(16, "lru", debug);
+
+  //
+  // the other replacement policies: final state only
+  //
+  const char *policies[] = { "clock", "2q", "arc", "lirs", "sa4" };
+  for (int p=0; p<5; p++) {
+    test(7, policies[p], false);
+    test(16, policies[p], false);
+  }
 
   return EXIT_SUCCESS;
 }
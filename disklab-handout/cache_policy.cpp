@@ -0,0 +1,428 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief replacement policies for the fully-associative BlockCache
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstdlib>
+
+#include <iostream>
+#include <iomanip>
+
+#include "cache_policy.h"
+using namespace std;
+
+/// @brief print the blocks of list @a l (head first) on one line
+static void dump_list(const char *name, const CacheList &l,
+                      const CacheLink *link, const uint64 *block)
+{
+  cout << "  " << setw(6) << left << name << right
+       << "(" << setw(6) << l.count << "): ";
+  for (uint32 n=l.head; n!=CACHE_NIL; n=link[n].next) cout << " " << block[n];
+  cout << endl;
+}
+
+/// @brief read the @a n flag or state bytes of array @a p from checkpoint
+///        @a in and check that none exceeds @a max
+/// @retval true on success
+static bool get_states(CheckpointReader &in, unsigned char *p, uint32 n,
+                       unsigned char max)
+{
+  if (!in.get_array(p, n)) return false;
+  for (uint32 i=0; i<n; i++) {
+    if (p[i] > max) return in.fail("corrupt cache state");
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// CacheIndex
+//
+CacheIndex::CacheIndex(uint32 entries)
+{
+  _nslots = entries + entries/2 + 1;
+  _slot = new uint32[_nslots];
+  for (uint32 i=0; i<_nslots; i++) _slot[i] = CACHE_NIL;
+}
+
+CacheIndex::~CacheIndex(void)
+{
+  delete [] _slot;
+}
+
+void CacheIndex::erase(uint32 n, const uint64 *key)
+{
+  uint32 s = home(key[n]);
+
+  while (_slot[s] != n) {
+    assert(_slot[s] != CACHE_NIL);
+    if (++s == _nslots) s = 0;
+  }
+
+  //
+  // backward-shift deletion: move following entries of the probe sequence
+  // into the hole unless their home slot lies (cyclically) in (hole, j]
+  //
+  uint32 j = s;
+  while (true) {
+    if (++j == _nslots) j = 0;
+    if (_slot[j] == CACHE_NIL) break;
+
+    uint32 k = home(key[_slot[j]]);
+    bool stay = (s <= j) ? ((s < k) && (k <= j)) : ((s < k) || (k <= j));
+    if (stay) continue;
+
+    _slot[s] = _slot[j];
+    s = j;
+  }
+  _slot[s] = CACHE_NIL;
+}
+
+void CacheIndex::save(CheckpointWriter &out) const
+{
+  out.put(_nslots);
+  out.put_array(_slot, _nslots);
+}
+
+bool CacheIndex::restore(CheckpointReader &in)
+{
+  uint32 nslots;
+  if (!in.get(nslots)) return false;
+  if (nslots != _nslots) return in.fail("the cache index size differs");
+
+  return in.get_array(_slot, _nslots);
+}
+
+//------------------------------------------------------------------------------
+// LRUPolicy
+//
+LRUPolicy::LRUPolicy(uint32 nblocks)
+  : _index(nblocks)
+{
+  _block = new uint64[nblocks];
+  _link = new CacheLink[nblocks];
+
+  //
+  // all nodes start out unused in the LRU list, in pool order
+  //
+  for (uint32 i=nblocks; i>0; i--) {
+    _block[i-1] = CACHE_INVALID;
+    _lru.push_front(_link, i-1);
+  }
+}
+
+LRUPolicy::~LRUPolicy(void)
+{
+  delete [] _block;
+  delete [] _link;
+}
+
+void LRUPolicy::dump(void) const
+{
+  cout << setw(10) << "lru" << setw(18) << "block" << setw(10) << "prev"
+       << setw(10) << "next" << setw(11) << "array idx" << endl;
+
+  uint32 lru = 0;
+  for (uint32 n=_lru.head; n!=CACHE_NIL; n=_link[n].next) {
+    cout << setw(10) << lru++;
+    if (_block[n] == CACHE_INVALID) cout << setw(18) << "invalid";
+    else cout << setw(18) << _block[n];
+    if (_link[n].prev == CACHE_NIL) cout << setw(10) << "-";
+    else cout << setw(10) << _link[n].prev;
+    if (_link[n].next == CACHE_NIL) cout << setw(10) << "-";
+    else cout << setw(10) << _link[n].next;
+    cout << setw(11) << n << endl;
+  }
+  cout << endl;
+}
+
+void LRUPolicy::save(CheckpointWriter &out, uint32 nblocks) const
+{
+  out.put_array(_block, nblocks);
+  out.put_array(_link, nblocks);
+  out.put(_lru);
+  _index.save(out);
+}
+
+bool LRUPolicy::restore(CheckpointReader &in, uint32 nblocks)
+{
+  return in.get_array(_block, nblocks) && in.get_array(_link, nblocks) &&
+         in.get(_lru) && _index.restore(in);
+}
+
+//------------------------------------------------------------------------------
+// ClockPolicy
+//
+ClockPolicy::ClockPolicy(uint32 nblocks)
+  : _nblocks(nblocks), _used(0), _hand(0), _index(nblocks)
+{
+  _block = new uint64[nblocks];
+  _ref = new unsigned char[nblocks];
+
+  for (uint32 i=0; i<nblocks; i++) {
+    _block[i] = CACHE_INVALID;
+    _ref[i] = 0;
+  }
+}
+
+ClockPolicy::~ClockPolicy(void)
+{
+  delete [] _block;
+  delete [] _ref;
+}
+
+void ClockPolicy::dump(void) const
+{
+  cout << setw(10) << "frame" << setw(18) << "block" << setw(6) << "ref"
+       << endl;
+
+  for (uint32 n=0; n<_nblocks; n++) {
+    cout << setw(10) << n;
+    if (_block[n] == CACHE_INVALID) cout << setw(18) << "invalid";
+    else cout << setw(18) << _block[n];
+    cout << setw(6) << (int)_ref[n] << (n == _hand ? "  <- hand" : "") << endl;
+  }
+  cout << endl;
+}
+
+void ClockPolicy::save(CheckpointWriter &out, uint32 nblocks) const
+{
+  out.put(_used);
+  out.put(_hand);
+  out.put_array(_block, _nblocks);
+  out.put_array(_ref, _nblocks);
+  _index.save(out);
+}
+
+bool ClockPolicy::restore(CheckpointReader &in, uint32 nblocks)
+{
+  return in.get(_used) && in.get(_hand) && in.get_array(_block, _nblocks) &&
+         get_states(in, _ref, _nblocks, 1) &&
+         _index.restore(in);
+}
+
+//------------------------------------------------------------------------------
+// TwoQPolicy
+//
+TwoQPolicy::TwoQPolicy(uint32 nblocks)
+  : _nblocks(nblocks), _index(nblocks + (nblocks/2 > 0 ? nblocks/2 : 1))
+{
+  _kin = nblocks/4 > 0 ? nblocks/4 : 1;
+  _kout = nblocks/2 > 0 ? nblocks/2 : 1;
+
+  uint32 nodes = _nblocks + _kout;
+  _block = new uint64[nodes];
+  _link = new CacheLink[nodes];
+  _where = new unsigned char[nodes];
+
+  for (uint32 i=0; i<nodes; i++) {
+    _block[i] = CACHE_INVALID;
+    _where[i] = FREE;
+    _free.push_front(_link, i);
+  }
+}
+
+TwoQPolicy::~TwoQPolicy(void)
+{
+  delete [] _block;
+  delete [] _link;
+  delete [] _where;
+}
+
+void TwoQPolicy::dump(void) const
+{
+  cout << "  Kin: " << _kin << ", Kout: " << _kout << endl;
+  dump_list("A1in", _a1in, _link, _block);
+  dump_list("A1out", _a1out, _link, _block);
+  dump_list("Am", _am, _link, _block);
+  cout << endl;
+}
+
+void TwoQPolicy::save(CheckpointWriter &out, uint32 nblocks) const
+{
+  uint32 nodes = _nblocks + _kout;
+
+  out.put_array(_block, nodes);
+  out.put_array(_link, nodes);
+  out.put_array(_where, nodes);
+  out.put(_a1in);
+  out.put(_a1out);
+  out.put(_am);
+  out.put(_free);
+  _index.save(out);
+}
+
+bool TwoQPolicy::restore(CheckpointReader &in, uint32 nblocks)
+{
+  uint32 nodes = _nblocks + _kout;
+
+  return in.get_array(_block, nodes) && in.get_array(_link, nodes) &&
+         get_states(in, _where, nodes, FREE) && in.get(_a1in) &&
+         in.get(_a1out) && in.get(_am) && in.get(_free) && _index.restore(in);
+}
+
+//------------------------------------------------------------------------------
+// ARCPolicy
+//
+ARCPolicy::ARCPolicy(uint32 nblocks)
+  : _nblocks(nblocks), _p(0), _index(2*nblocks)
+{
+  uint32 nodes = 2*_nblocks;
+  _block = new uint64[nodes];
+  _link = new CacheLink[nodes];
+  _where = new unsigned char[nodes];
+
+  for (uint32 i=0; i<nodes; i++) {
+    _block[i] = CACHE_INVALID;
+    _where[i] = FREE;
+    _free.push_front(_link, i);
+  }
+}
+
+ARCPolicy::~ARCPolicy(void)
+{
+  delete [] _block;
+  delete [] _link;
+  delete [] _where;
+}
+
+void ARCPolicy::dump(void) const
+{
+  cout << "  p: " << _p << endl;
+  dump_list("T1", _t1, _link, _block);
+  dump_list("T2", _t2, _link, _block);
+  dump_list("B1", _b1, _link, _block);
+  dump_list("B2", _b2, _link, _block);
+  cout << endl;
+}
+
+void ARCPolicy::save(CheckpointWriter &out, uint32 nblocks) const
+{
+  uint32 nodes = 2*_nblocks;
+
+  out.put(_p);
+  out.put_array(_block, nodes);
+  out.put_array(_link, nodes);
+  out.put_array(_where, nodes);
+  out.put(_t1);
+  out.put(_t2);
+  out.put(_b1);
+  out.put(_b2);
+  out.put(_free);
+  _index.save(out);
+}
+
+bool ARCPolicy::restore(CheckpointReader &in, uint32 nblocks)
+{
+  uint32 nodes = 2*_nblocks;
+
+  return in.get(_p) && in.get_array(_block, nodes) &&
+         in.get_array(_link, nodes) && get_states(in, _where, nodes, FREE) &&
+         in.get(_t1) && in.get(_t2) && in.get(_b1) && in.get(_b2) &&
+         in.get(_free) && _index.restore(in);
+}
+
+//------------------------------------------------------------------------------
+// LIRSPolicy
+//
+LIRSPolicy::LIRSPolicy(uint32 nblocks)
+  : _nblocks(nblocks), _nlir(0), _index(2*nblocks)
+{
+  uint32 hirs = nblocks/100 > 0 ? nblocks/100 : 1;
+  _lirs = nblocks - hirs;
+
+  uint32 nodes = 2*_nblocks;
+  _block = new uint64[nodes];
+  _slink = new CacheLink[nodes];
+  _qlink = new CacheLink[nodes];
+  _state = new unsigned char[nodes];
+  _in_s = new unsigned char[nodes];
+
+  for (uint32 i=0; i<nodes; i++) {
+    _block[i] = CACHE_INVALID;
+    _state[i] = FREE;
+    _in_s[i] = 0;
+    _free.push_front(_slink, i);
+  }
+}
+
+LIRSPolicy::~LIRSPolicy(void)
+{
+  delete [] _block;
+  delete [] _slink;
+  delete [] _qlink;
+  delete [] _state;
+  delete [] _in_s;
+}
+
+void LIRSPolicy::dump(void) const
+{
+  cout << "  LIR blocks: " << _nlir << " / " << _lirs << endl;
+  cout << "  " << setw(6) << left << "S" << right
+       << "(" << setw(6) << _s.count << "): ";
+  for (uint32 n=_s.head; n!=CACHE_NIL; n=_slink[n].next) {
+    cout << " " << _block[n]
+         << (_state[n] == LIR ? "L" : (_state[n] == HIR ? "H" : "n"));
+  }
+  cout << endl;
+  dump_list("Q", _q, _qlink, _block);
+  dump_list("NR", _nr, _qlink, _block);
+  cout << endl;
+}
+
+void LIRSPolicy::save(CheckpointWriter &out, uint32 nblocks) const
+{
+  uint32 nodes = 2*_nblocks;
+
+  out.put(_nlir);
+  out.put_array(_block, nodes);
+  out.put_array(_slink, nodes);
+  out.put_array(_qlink, nodes);
+  out.put_array(_state, nodes);
+  out.put_array(_in_s, nodes);
+  out.put(_s);
+  out.put(_q);
+  out.put(_nr);
+  out.put(_free);
+  _index.save(out);
+}
+
+bool LIRSPolicy::restore(CheckpointReader &in, uint32 nblocks)
+{
+  uint32 nodes = 2*_nblocks;
+
+  return in.get(_nlir) && in.get_array(_block, nodes) &&
+         in.get_array(_slink, nodes) && in.get_array(_qlink, nodes) &&
+         get_states(in, _state, nodes, FREE) &&
+         get_states(in, _in_s, nodes, 1) &&
+         in.get(_s) && in.get(_q) && in.get(_nr) && in.get(_free) &&
+         _index.restore(in);
+}
@@ -0,0 +1,992 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief replacement policies for the fully-associative BlockCache
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_CACHE_POLICY_H__
+#define __CA_CACHE_POLICY_H__
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "cache.h"
+
+//------------------------------------------------------------------------------
+// The replacement policies below all share the same layout: the cached (and,
+// for the scan-resistant policies, the recently evicted "ghost") blocks live
+// in a fixed-size pool of nodes addressed by 32-bit indices. Block numbers
+// are stored in a separate array (_block[]) that doubles as the key array of
+// the CacheIndex hash table; the policy-specific lists are threaded through
+// CacheLink arrays. No memory is allocated after construction.
+//
+// A policy class provides
+//   static const char* name(void)   policy name as used in the configuration
+//   static uint32 blocks(uint32 nblocks)
+//                                   number of blocks a cache of nblocks holds
+//   bool has(uint64 block) const    is the block resident?
+//   bool access(uint64 block)       reference a block, bring it in on a miss
+//   void dump(void) const           print the policy state to stdout
+//   void save(CheckpointWriter &out, uint32 nblocks) const
+//   bool restore(CheckpointReader &in, uint32 nblocks)
+//                                   write/read the node pool, lists and index
+//                                   of a cache of nblocks blocks (checkpoints)
+// and is plugged into the PolicyCache template at the end of this file.
+//
+
+static const uint32 CACHE_NIL = ~0U;          ///< null node/slot index
+static const uint64 CACHE_INVALID = ~0ULL;    ///< block number of free nodes
+
+///@brief link of a node in a CacheList
+typedef struct CacheLink {
+  uint32 prev;                      ///< previous (more recent) node or NIL
+  uint32 next;                      ///< next (less recent) node or NIL
+} CacheLink;
+
+//------------------------------------------------------------------------------
+/// @brief doubly-linked list threaded through an array of CacheLinks
+///
+/// The head of the list is the most recent, the tail the least recent end.
+///
+class CacheList {
+  public:
+    uint32 head;                    ///< most recent node or NIL
+    uint32 tail;                    ///< least recent node or NIL
+    uint32 count;                   ///< number of nodes in the list
+
+    /// @brief constructor: empty list
+    CacheList(void) : head(CACHE_NIL), tail(CACHE_NIL), count(0) {};
+
+    /// @brief insert node @a n at the head of the list
+    void push_front(CacheLink *l, uint32 n)
+    {
+      l[n].prev = CACHE_NIL;
+      l[n].next = head;
+      if (head != CACHE_NIL) l[head].prev = n;
+      else tail = n;
+      head = n;
+      count++;
+    }
+
+    /// @brief unlink node @a n
+    void remove(CacheLink *l, uint32 n)
+    {
+      if (l[n].prev != CACHE_NIL) l[l[n].prev].next = l[n].next;
+      else head = l[n].next;
+      if (l[n].next != CACHE_NIL) l[l[n].next].prev = l[n].prev;
+      else tail = l[n].prev;
+      count--;
+    }
+
+    /// @brief move node @a n (which must be in this list) to the head
+    void move_front(CacheLink *l, uint32 n)
+    {
+      if (n == head) return;
+      remove(l, n);
+      push_front(l, n);
+    }
+
+    /// @brief unlink and return the tail of a non-empty list
+    uint32 pop_back(CacheLink *l)
+    {
+      uint32 n = tail;
+      remove(l, n);
+      return n;
+    }
+};
+
+//------------------------------------------------------------------------------
+/// @brief open-addressing hash table mapping block numbers to node indices
+///
+/// Linear probing with backward-shift deletion at a load factor of at most
+/// 2/3 (1.5 four-byte slots per entry). The table stores node indices only;
+/// keys are looked up in the owner's block array passed to each operation.
+///
+class CacheIndex {
+  public:
+    /// @brief constructor
+    /// @param entries maximum number of entries
+    CacheIndex(uint32 entries);
+
+    /// @brief destructor
+    ~CacheIndex(void);
+
+    /// @brief find the node holding @a block
+    /// @retval node index or NIL if @a block is not in the table
+    uint32 find(uint64 block, const uint64 *key) const
+    {
+      uint32 s = home(block);
+
+      while (_slot[s] != CACHE_NIL) {
+        if (key[_slot[s]] == block) return _slot[s];
+        if (++s == _nslots) s = 0;
+      }
+
+      return CACHE_NIL;
+    }
+
+    /// @brief insert node @a n with key @a key[n]
+    void insert(uint32 n, const uint64 *key)
+    {
+      uint32 s = home(key[n]);
+
+      while (_slot[s] != CACHE_NIL) {
+        if (++s == _nslots) s = 0;
+      }
+      _slot[s] = n;
+    }
+
+    /// @brief remove node @a n with key @a key[n]
+    void erase(uint32 n, const uint64 *key);
+
+    /// @brief write the table to checkpoint @a out
+    void save(CheckpointWriter &out) const;
+
+    /// @brief read a table of the same size from checkpoint @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    uint32 *_slot;                  ///< node index or NIL
+    uint32 _nslots;                 ///< number of slots
+
+    /// @brief home slot of @a block
+    uint32 home(uint64 block) const
+    {
+      // multiplicative hashing, mapped onto [0, _nslots) without a division
+      uint64 h = (block * 0x9e3779b97f4a7c15ULL) >> 32;
+      return (uint32)((h * _nslots) >> 32);
+    }
+
+  private:
+    CacheIndex(const CacheIndex&);
+    CacheIndex& operator=(const CacheIndex&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief least recently used
+///
+/// All nodes are always in the LRU list; unused nodes hold CACHE_INVALID and
+/// start out in pool order. A miss recycles the tail of the list.
+/// Memory: 16 bytes/node + 6 bytes of hash table = 22 bytes per cache block.
+///
+class LRUPolicy {
+  public:
+    LRUPolicy(uint32 nblocks);
+    ~LRUPolicy(void);
+
+    static const char* name(void) { return "lru"; }
+    static uint32 blocks(uint32 nblocks) { return nblocks; }
+
+    bool has(uint64 block) const
+    {
+      return _index.find(block, _block) != CACHE_NIL;
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 n = _index.find(block, _block);
+      bool hit = n != CACHE_NIL;
+
+      if (!hit) {
+        n = _lru.tail;
+        if (_block[n] != CACHE_INVALID) _index.erase(n, _block);
+        _block[n] = block;
+        _index.insert(n, _block);
+      }
+      _lru.move_front(_link, n);
+
+      return hit;
+    }
+
+    void dump(void) const;
+    void save(CheckpointWriter &out, uint32 nblocks) const;
+    bool restore(CheckpointReader &in, uint32 nblocks);
+
+  protected:
+    uint64    *_block;              ///< block number of each node
+    CacheLink *_link;               ///< LRU list links
+    CacheList  _lru;                ///< LRU list (MRU at head)
+    CacheIndex _index;              ///< block -> node
+
+  private:
+    LRUPolicy(const LRUPolicy&);
+    LRUPolicy& operator=(const LRUPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief CLOCK (second chance)
+///
+/// Frames are filled in order; once full, the clock hand skips (and clears)
+/// frames whose reference bit is set and replaces the first frame without.
+/// Newly loaded blocks start with a cleared reference bit.
+/// Memory: 9 bytes/node + 6 bytes of hash table = 15 bytes per cache block.
+///
+class ClockPolicy {
+  public:
+    ClockPolicy(uint32 nblocks);
+    ~ClockPolicy(void);
+
+    static const char* name(void) { return "clock"; }
+    static uint32 blocks(uint32 nblocks) { return nblocks; }
+
+    bool has(uint64 block) const
+    {
+      return _index.find(block, _block) != CACHE_NIL;
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 n = _index.find(block, _block);
+
+      if (n != CACHE_NIL) {
+        _ref[n] = 1;
+        return true;
+      }
+
+      if (_used < _nblocks) {
+        n = _used++;
+      } else {
+        while (_ref[_hand]) {
+          _ref[_hand] = 0;
+          if (++_hand == _nblocks) _hand = 0;
+        }
+        n = _hand;
+        if (++_hand == _nblocks) _hand = 0;
+        _index.erase(n, _block);
+      }
+
+      _block[n] = block;
+      _ref[n] = 0;
+      _index.insert(n, _block);
+
+      return false;
+    }
+
+    void dump(void) const;
+    void save(CheckpointWriter &out, uint32 nblocks) const;
+    bool restore(CheckpointReader &in, uint32 nblocks);
+
+  protected:
+    uint32     _nblocks;            ///< number of frames
+    uint32     _used;               ///< number of frames filled so far
+    uint32     _hand;               ///< clock hand
+    uint64    *_block;              ///< block number of each frame
+    unsigned char *_ref;            ///< reference bit of each frame
+    CacheIndex _index;              ///< block -> frame
+
+  private:
+    ClockPolicy(const ClockPolicy&);
+    ClockPolicy& operator=(const ClockPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief 2Q (Johnson & Shasha, full version)
+///
+/// First-time blocks enter the FIFO A1in (at most Kin = size/4 blocks). Blocks
+/// leaving A1in are remembered in the ghost FIFO A1out (Kout = size/2
+/// entries, no data). Only blocks that are re-referenced while in A1out are
+/// promoted to the LRU list Am, so a scan does not flush Am.
+/// Memory: size + Kout nodes of 17 bytes + hash table = 34 bytes per block.
+///
+class TwoQPolicy {
+  public:
+    TwoQPolicy(uint32 nblocks);
+    ~TwoQPolicy(void);
+
+    static const char* name(void) { return "2q"; }
+    static uint32 blocks(uint32 nblocks) { return nblocks; }
+
+    bool has(uint64 block) const
+    {
+      uint32 n = _index.find(block, _block);
+      return (n != CACHE_NIL) && (_where[n] != A1OUT);
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 n = _index.find(block, _block);
+
+      if (n != CACHE_NIL) {
+        if (_where[n] == AM) {
+          _am.move_front(_link, n);
+          return true;
+        }
+        if (_where[n] == A1IN) return true;
+
+        // remembered in A1out: bring back into Am
+        _a1out.remove(_link, n);
+        reclaim();
+      } else {
+        reclaim();
+        n = _free.pop_back(_link);
+        _block[n] = block;
+        _index.insert(n, _block);
+        _where[n] = A1IN;
+        _a1in.push_front(_link, n);
+        return false;
+      }
+
+      _where[n] = AM;
+      _am.push_front(_link, n);
+      return false;
+    }
+
+    void dump(void) const;
+    void save(CheckpointWriter &out, uint32 nblocks) const;
+    bool restore(CheckpointReader &in, uint32 nblocks);
+
+  protected:
+    enum { A1IN, A1OUT, AM, FREE };
+
+    uint32     _nblocks;            ///< number of cache blocks
+    uint32     _kin;                ///< max. size of A1in
+    uint32     _kout;               ///< max. size of A1out
+    uint64    *_block;              ///< block number of each node
+    CacheLink *_link;               ///< list links
+    unsigned char *_where;          ///< list a node is in
+    CacheList  _a1in;               ///< resident first-time blocks (FIFO)
+    CacheList  _a1out;              ///< ghosts of blocks evicted from A1in
+    CacheList  _am;                 ///< resident hot blocks (LRU)
+    CacheList  _free;               ///< unused nodes
+    CacheIndex _index;              ///< block -> node
+
+    /// @brief make room for one resident block if the cache is full
+    void reclaim(void)
+    {
+      if (_a1in.count + _am.count < _nblocks) return;
+
+      uint32 n;
+      if ((_a1in.count > _kin) || (_am.count == 0)) {
+        n = _a1in.pop_back(_link);
+        _where[n] = A1OUT;
+        _a1out.push_front(_link, n);
+        if (_a1out.count <= _kout) return;
+        n = _a1out.pop_back(_link);
+      } else {
+        n = _am.pop_back(_link);
+      }
+
+      _index.erase(n, _block);
+      _block[n] = CACHE_INVALID;
+      _where[n] = FREE;
+      _free.push_front(_link, n);
+    }
+
+  private:
+    TwoQPolicy(const TwoQPolicy&);
+    TwoQPolicy& operator=(const TwoQPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief ARC, adaptive replacement cache (Megiddo & Modha)
+///
+/// T1 holds blocks seen once recently, T2 blocks seen at least twice; B1/B2
+/// remember the blocks recently evicted from T1/T2. A hit in B1 (B2) grows
+/// (shrinks) the target size p of T1, so the split between recency and
+/// frequency adapts to the workload.
+/// Memory: 2*size nodes of 17 bytes + hash table = 68 bytes per block.
+///
+class ARCPolicy {
+  public:
+    ARCPolicy(uint32 nblocks);
+    ~ARCPolicy(void);
+
+    static const char* name(void) { return "arc"; }
+    static uint32 blocks(uint32 nblocks) { return nblocks; }
+
+    bool has(uint64 block) const
+    {
+      uint32 n = _index.find(block, _block);
+      return (n != CACHE_NIL) && ((_where[n] == T1) || (_where[n] == T2));
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 n = _index.find(block, _block);
+
+      if (n != CACHE_NIL) {
+        switch (_where[n]) {
+          case T1:
+            _t1.remove(_link, n);
+            break;
+
+          case T2:
+            _t2.move_front(_link, n);
+            return true;
+
+          case B1: {
+            uint32 delta = _b2.count > _b1.count ? _b2.count/_b1.count : 1;
+            _p = _p + delta < _nblocks ? _p + delta : _nblocks;
+            replace(false);
+            _b1.remove(_link, n);
+            break;
+          }
+
+          case B2: {
+            uint32 delta = _b1.count > _b2.count ? _b1.count/_b2.count : 1;
+            _p = _p > delta ? _p - delta : 0;
+            replace(true);
+            _b2.remove(_link, n);
+            break;
+          }
+        }
+
+        bool hit = _where[n] == T1;
+        _where[n] = T2;
+        _t2.push_front(_link, n);
+        return hit;
+      }
+
+      //
+      // not in the directory
+      //
+      uint32 l1 = _t1.count + _b1.count;
+      if (l1 == _nblocks) {
+        if (_t1.count < _nblocks) {
+          drop(_b1.pop_back(_link));
+          replace(false);
+        } else {
+          drop(_t1.pop_back(_link));
+        }
+      } else {
+        uint32 total = l1 + _t2.count + _b2.count;
+        if (total >= _nblocks) {
+          if (total == 2*_nblocks) drop(_b2.pop_back(_link));
+          replace(false);
+        }
+      }
+
+      n = _free.pop_back(_link);
+      _block[n] = block;
+      _index.insert(n, _block);
+      _where[n] = T1;
+      _t1.push_front(_link, n);
+
+      return false;
+    }
+
+    void dump(void) const;
+    void save(CheckpointWriter &out, uint32 nblocks) const;
+    bool restore(CheckpointReader &in, uint32 nblocks);
+
+  protected:
+    enum { T1, T2, B1, B2, FREE };
+
+    uint32     _nblocks;            ///< number of cache blocks (c)
+    uint32     _p;                  ///< target size of T1
+    uint64    *_block;              ///< block number of each node
+    CacheLink *_link;               ///< list links
+    unsigned char *_where;          ///< list a node is in
+    CacheList  _t1, _t2;            ///< resident blocks
+    CacheList  _b1, _b2;            ///< ghosts of blocks evicted from T1/T2
+    CacheList  _free;               ///< unused nodes
+    CacheIndex _index;              ///< block -> node
+
+    /// @brief evict one resident block into B1 or B2 if the cache is full
+    /// @param in_b2 the block being referenced was found in B2
+    void replace(bool in_b2)
+    {
+      if (_t1.count + _t2.count < _nblocks) return;
+
+      uint32 n;
+      if ((_t1.count > 0) &&
+          ((_t1.count > _p) || (in_b2 && (_t1.count == _p)) ||
+           (_t2.count == 0))) {
+        n = _t1.pop_back(_link);
+        _where[n] = B1;
+        _b1.push_front(_link, n);
+      } else {
+        n = _t2.pop_back(_link);
+        _where[n] = B2;
+        _b2.push_front(_link, n);
+      }
+    }
+
+    /// @brief forget node @a n entirely
+    void drop(uint32 n)
+    {
+      _index.erase(n, _block);
+      _block[n] = CACHE_INVALID;
+      _where[n] = FREE;
+      _free.push_front(_link, n);
+    }
+
+  private:
+    ARCPolicy(const ARCPolicy&);
+    ARCPolicy& operator=(const ARCPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief LIRS, low inter-reference recency set (Jiang & Zhang)
+///
+/// Blocks are LIR (low inter-reference recency, resident) or HIR. The LIR set
+/// takes all but Lhirs = max(1, size/100) of the cache; resident HIR blocks
+/// are kept in the FIFO Q and are the only eviction candidates. The recency
+/// stack S holds LIR blocks and recently referenced HIR blocks (resident or
+/// not); a HIR block referenced again while in S becomes LIR and the LIR
+/// block at the bottom of S is demoted. Non-resident HIR entries are capped
+/// at size and kept in the FIFO NR (sharing Q's links) for removal.
+/// Memory: 2*size nodes of 25 bytes + hash table = 62 bytes per block.
+///
+class LIRSPolicy {
+  public:
+    LIRSPolicy(uint32 nblocks);
+    ~LIRSPolicy(void);
+
+    static const char* name(void) { return "lirs"; }
+    static uint32 blocks(uint32 nblocks) { return nblocks; }
+
+    bool has(uint64 block) const
+    {
+      uint32 n = _index.find(block, _block);
+      return (n != CACHE_NIL) && (_state[n] != NHIR);
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 n = _index.find(block, _block);
+
+      if (n != CACHE_NIL) {
+        switch (_state[n]) {
+          case LIR:
+            _s.move_front(_slink, n);
+            prune();
+            return true;
+
+          case HIR:
+            if (_in_s[n]) {
+              _q.remove(_qlink, n);
+              _s.move_front(_slink, n);
+              promote(n);
+            } else {
+              _q.move_front(_qlink, n);
+              _s.push_front(_slink, n);
+              _in_s[n] = 1;
+            }
+            return true;
+
+          case NHIR:
+            _nr.remove(_qlink, n);
+            make_room();
+            _s.move_front(_slink, n);
+            promote(n);
+            return false;
+        }
+      }
+
+      //
+      // new block
+      //
+      make_room();
+      n = _free.pop_back(_slink);
+      _block[n] = block;
+      _index.insert(n, _block);
+      _s.push_front(_slink, n);
+      _in_s[n] = 1;
+      if (_nlir < _lirs) {
+        _state[n] = LIR;
+        _nlir++;
+      } else {
+        _state[n] = HIR;
+        _q.push_front(_qlink, n);
+      }
+
+      return false;
+    }
+
+    void dump(void) const;
+    void save(CheckpointWriter &out, uint32 nblocks) const;
+    bool restore(CheckpointReader &in, uint32 nblocks);
+
+  protected:
+    enum { LIR, HIR, NHIR, FREE };
+
+    uint32     _nblocks;            ///< number of cache blocks
+    uint32     _lirs;               ///< max. number of LIR blocks
+    uint32     _nlir;               ///< current number of LIR blocks
+    uint64    *_block;              ///< block number of each node
+    CacheLink *_slink;              ///< links of S (and of the free list)
+    CacheLink *_qlink;              ///< links of Q and NR
+    unsigned char *_state;          ///< LIR, HIR, NHIR or FREE
+    unsigned char *_in_s;           ///< node is in S
+    CacheList  _s;                  ///< recency stack S (top at head)
+    CacheList  _q;                  ///< resident HIR blocks (FIFO)
+    CacheList  _nr;                 ///< non-resident HIR blocks in S (FIFO)
+    CacheList  _free;               ///< unused nodes
+    CacheIndex _index;              ///< block -> node
+
+    /// @brief turn node @a n (at the top of S) into a LIR block, demoting
+    ///        the bottom LIR block if the LIR set is full
+    void promote(uint32 n)
+    {
+      _state[n] = LIR;
+      if (++_nlir > _lirs) {
+        prune();
+        uint32 m = _s.pop_back(_slink);
+        _in_s[m] = 0;
+        _state[m] = HIR;
+        _nlir--;
+        _q.push_front(_qlink, m);
+      }
+      prune();
+    }
+
+    /// @brief remove HIR entries from the bottom of S
+    void prune(void)
+    {
+      while ((_s.tail != CACHE_NIL) && (_state[_s.tail] != LIR)) {
+        uint32 m = _s.pop_back(_slink);
+        _in_s[m] = 0;
+        if (_state[m] == NHIR) {
+          _nr.remove(_qlink, m);
+          drop(m);
+        }
+      }
+    }
+
+    /// @brief evict the oldest resident HIR block if the cache is full
+    void make_room(void)
+    {
+      if (_nlir + _q.count < _nblocks) return;
+
+      uint32 m = _q.pop_back(_qlink);
+      if (!_in_s[m]) {
+        drop(m);
+        return;
+      }
+
+      _state[m] = NHIR;
+      _nr.push_front(_qlink, m);
+      if (_nr.count > _nblocks) {
+        m = _nr.pop_back(_qlink);
+        _s.remove(_slink, m);
+        _in_s[m] = 0;
+        drop(m);
+      }
+    }
+
+    /// @brief forget node @a n entirely (must not be in any list)
+    void drop(uint32 n)
+    {
+      _index.erase(n, _block);
+      _block[n] = CACHE_INVALID;
+      _state[n] = FREE;
+      _free.push_front(_slink, n);
+    }
+
+  private:
+    LIRSPolicy(const LIRSPolicy&);
+    LIRSPolicy& operator=(const LIRSPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief set-associative cache with LRU replacement within a set
+///
+/// A block maps to set block % sets and is identified by the 64-bit tag
+/// block / sets. The WAYS tags of a set are stored contiguously and aligned
+/// (8 ways = one 64-byte cache line) and compared against the requested tag
+/// with one SSE2 (or, if compiled with AVX2, AVX2) compare per 2 (4) ways.
+/// The LRU order within a set is kept as a rank byte per way (0 = MRU); ways
+/// that were never used keep the highest ranks and are replaced first.
+///
+/// The number of cache blocks is rounded down to a multiple of WAYS (at least
+/// one set; see blocks()).
+/// Sets are independent: accesses to different sets may run concurrently
+/// (see setsim.h).
+/// Memory: 9 bytes per cache block.
+///
+template <uint32 WAYS>
+class SetAssocPolicy {
+  public:
+    SetAssocPolicy(uint32 nblocks)
+    {
+      _nsets = nblocks/WAYS > 0 ? nblocks/WAYS : 1;
+      _tag = new TagLine[_nsets];
+      _rank = new unsigned char[(size_t)_nsets*WAYS];
+
+      for (uint32 s=0; s<_nsets; s++) {
+        for (uint32 w=0; w<WAYS; w++) {
+          _tag[s].tag[w] = INVALID_TAG;
+          _rank[(size_t)s*WAYS+w] = (unsigned char)w;
+        }
+      }
+    }
+
+    ~SetAssocPolicy(void)
+    {
+      delete [] _tag;
+      delete [] _rank;
+    }
+
+    static const char* name(void)
+    {
+      return WAYS == 4 ? "sa4" : (WAYS == 8 ? "sa8" : "sa16");
+    }
+
+    /// @brief number of blocks held by a cache of @a nblocks blocks
+    static uint32 blocks(uint32 nblocks)
+    {
+      return nblocks/WAYS > 0 ? nblocks/WAYS*WAYS : WAYS;
+    }
+
+    /// @brief number of sets
+    uint32 sets(void) const { return _nsets; }
+
+    /// @brief set index of @a block
+    uint32 set_of(uint64 block) const { return (uint32)(block % _nsets); }
+
+    bool has(uint64 block) const
+    {
+      uint32 s = set_of(block);
+      return match(_tag[s].tag, block / _nsets) >= 0;
+    }
+
+    bool access(uint64 block)
+    {
+      uint32 s = set_of(block);
+      uint64 tag = block / _nsets;
+      int w = match(_tag[s].tag, tag);
+      bool hit = w >= 0;
+
+      assert(tag < INVALID_TAG);
+
+      unsigned char *rank = &_rank[(size_t)s*WAYS];
+      if (!hit) {
+        for (w=0; rank[w] != WAYS-1; w++);
+        _tag[s].tag[w] = tag;
+      }
+
+      unsigned char r = rank[w];
+      for (uint32 v=0; v<WAYS; v++) {
+        if (rank[v] < r) rank[v]++;
+      }
+      rank[w] = 0;
+
+      return hit;
+    }
+
+    void dump(void) const
+    {
+      std::cout << std::setw(10) << "set" << "  blocks (MRU first)"
+                << std::endl;
+
+      for (uint32 s=0; s<_nsets; s++) {
+        std::cout << std::setw(10) << s << " ";
+        for (uint32 r=0; r<WAYS; r++) {
+          for (uint32 w=0; w<WAYS; w++) {
+            if (_rank[(size_t)s*WAYS+w] != r) continue;
+            if (_tag[s].tag[w] == INVALID_TAG) std::cout << " -";
+            else std::cout << " " << _tag[s].tag[w]*_nsets + s;
+          }
+        }
+        std::cout << std::endl;
+      }
+      std::cout << std::endl;
+    }
+
+    void save(CheckpointWriter &out, uint32 nblocks) const
+    {
+      out.put(_nsets);
+      out.put_array(_tag, _nsets);
+      out.put_array(_rank, (size_t)_nsets*WAYS);
+    }
+
+    bool restore(CheckpointReader &in, uint32 nblocks)
+    {
+      uint32 nsets;
+      if (!in.get(nsets)) return false;
+      if (nsets != _nsets) return in.fail("the number of cache sets differs");
+
+      return in.get_array(_tag, _nsets) &&
+             in.get_array(_rank, (size_t)_nsets*WAYS);
+    }
+
+  protected:
+    static const uint64 INVALID_TAG = ~0ULL;
+
+    /// @brief tags of one set
+    struct alignas(WAYS*sizeof(uint64)) TagLine {
+      uint64 tag[WAYS];
+    };
+
+    uint32  _nsets;                 ///< number of sets
+    TagLine *_tag;                  ///< tags, one line per set
+    unsigned char *_rank;           ///< LRU rank of each way (0 = MRU)
+
+    /// @brief find @a tag in the tag line @a t
+    /// @retval way holding @a tag or -1
+    static int match(const uint64 *t, uint64 tag)
+    {
+      uint32 mask = 0;
+
+#if defined(__AVX2__)
+      __m256i key = _mm256_set1_epi64x((long long)tag);
+      for (uint32 i=0; i<WAYS; i+=4) {
+        __m256i v = _mm256_load_si256((const __m256i*)&t[i]);
+        __m256d eq = _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, key));
+        mask |= (uint32)_mm256_movemask_pd(eq) << i;
+      }
+#elif defined(__SSE2__)
+      // SSE2 has no 64-bit compare: a way matches if both its halves do
+      __m128i key = _mm_set1_epi64x((long long)tag);
+      for (uint32 i=0; i<WAYS; i+=2) {
+        __m128i v = _mm_load_si128((const __m128i*)&t[i]);
+        __m128i eq = _mm_cmpeq_epi32(v, key);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (uint32)_mm_movemask_pd(_mm_castsi128_pd(eq)) << i;
+      }
+#else
+      for (uint32 i=0; i<WAYS; i++) {
+        if (t[i] == tag) mask |= 1U << i;
+      }
+#endif
+
+      return mask ? __builtin_ctz(mask) : -1;
+    }
+
+  private:
+    SetAssocPolicy(const SetAssocPolicy&);
+    SetAssocPolicy& operator=(const SetAssocPolicy&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief BlockCache with replacement policy @a Policy
+///
+/// get_range()/put_range() loop over the inlined policy access, so a request
+/// costs one virtual call regardless of its length, but one policy access
+/// per block. Under LRU, put_range() of more blocks than the cache holds
+/// inserts only the last ones: the others would be evicted by the range
+/// itself, and the resulting cache contents are the same.
+///
+template <class Policy>
+class PolicyCache : public BlockCache {
+  public:
+    /// @brief constructor
+    /// @param nblocks number of cache blocks (MUST BE >= 2!)
+    /// @param verbose verbose output
+    /// @param quiet do not print the cache parameters
+    PolicyCache(uint32 nblocks, bool verbose=false, bool quiet=false)
+      : BlockCache(Policy::blocks(nblocks), Policy::name(), verbose, quiet),
+        _policy(nblocks) {};
+
+    /// @brief destructor
+    virtual ~PolicyCache(void) {};
+
+    virtual void dump(void) const
+    {
+      BlockCache::dump();
+      _policy.dump();
+    }
+
+    virtual bool has(uint64 block) const
+    {
+      return _policy.has(block);
+    }
+
+    virtual bool get(uint64 block)
+    {
+      return access(block);
+    }
+
+    virtual void put(uint64 block)
+    {
+      _policy.access(block);
+    }
+
+    virtual uint64 get_range(uint64 block, uint64 nblocks)
+    {
+      uint64 miss = 0;
+
+      for (uint64 b=block; b<block+nblocks; b++) {
+        if (!access(b)) miss++;
+      }
+
+      return miss;
+    }
+
+    virtual void put_range(uint64 block, uint64 nblocks)
+    {
+      if (is_same<Policy, LRUPolicy>::value && (nblocks > _nblocks)) {
+        block += nblocks - _nblocks;
+        nblocks = _nblocks;
+      }
+      for (uint64 b=block; b<block+nblocks; b++) _policy.access(b);
+    }
+
+    virtual void save(CheckpointWriter &out) const
+    {
+      BlockCache::save(out);
+      _policy.save(out, _nblocks);
+    }
+
+    virtual bool restore(CheckpointReader &in)
+    {
+      return BlockCache::restore(in) && _policy.restore(in, _nblocks);
+    }
+
+    /// @brief non-virtual get()
+    bool access(uint64 block)
+    {
+      bool hit = _policy.access(block);
+
+      if (hit) _hit++;
+      else _miss++;
+
+      if (_verbose) {
+        std::cout << "BlockCache::get(" << std::dec << block << "): "
+                  << (hit ? "hit" : "miss") << std::endl;
+      }
+
+      return hit;
+    }
+
+  protected:
+    Policy _policy;                 ///< replacement policy
+};
+
+typedef PolicyCache<LRUPolicy>   LRUCache;     ///< LRU BlockCache
+typedef PolicyCache<ClockPolicy> ClockCache;   ///< CLOCK BlockCache
+typedef PolicyCache<TwoQPolicy>  TwoQCache;    ///< 2Q BlockCache
+typedef PolicyCache<ARCPolicy>   ARCCache;     ///< ARC BlockCache
+typedef PolicyCache<LIRSPolicy>  LIRSCache;    ///< LIRS BlockCache
+typedef PolicyCache<SetAssocPolicy<4> >  SA4Cache;  ///< 4-way BlockCache
+typedef PolicyCache<SetAssocPolicy<8> >  SA8Cache;  ///< 8-way BlockCache
+typedef PolicyCache<SetAssocPolicy<16> > SA16Cache; ///< 16-way BlockCache
+
+#endif // __CA_CACHE_POLICY_H__
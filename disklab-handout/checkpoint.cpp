@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief checkpoint files of the simulator state
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstring>
+#include <iostream>
+
+#include "checkpoint.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// CheckpointWriter
+//
+CheckpointWriter::CheckpointWriter(const char *path)
+  : _out(fopen(path, "wb")), _error(false), _bytes(0), _length(-1)
+{
+  if (_out == NULL) {
+    _error = true;
+    return;
+  }
+  setvbuf(_out, NULL, _IOFBF, CHECKPOINT_BUFFER);
+
+  uint32 version = CHECKPOINT_VERSION;
+  put(CHECKPOINT_MAGIC, strlen(CHECKPOINT_MAGIC));
+  put(version);
+}
+
+CheckpointWriter::~CheckpointWriter(void)
+{
+  close();
+}
+
+bool CheckpointWriter::valid(void) const
+{
+  return !_error;
+}
+
+void CheckpointWriter::section(const char *tag)
+{
+  uint64 length = 0;
+
+  end_section();
+  put(tag, 4);
+  if (!_error) _length = ftell(_out);
+  put(length);
+}
+
+void CheckpointWriter::end_section(void)
+{
+  if (_error || (_length < 0)) return;
+
+  long end = ftell(_out);
+  uint64 length = end - _length - sizeof(length);
+  if ((end < 0) || (fseek(_out, _length, SEEK_SET) != 0) ||
+      (fwrite(&length, sizeof(length), 1, _out) != 1) ||
+      (fseek(_out, end, SEEK_SET) != 0)) {
+    _error = true;
+  }
+  _length = -1;
+}
+
+void CheckpointWriter::put(const void *p, size_t n)
+{
+  if (_error || (n == 0)) return;
+  if (fwrite(p, 1, n, _out) != n) _error = true;
+  _bytes += n;
+}
+
+void CheckpointWriter::put_string(const string &s)
+{
+  uint32 len = s.size();
+  put(len);
+  put(s.data(), len);
+}
+
+bool CheckpointWriter::close(void)
+{
+  if (_out != NULL) {
+    end_section();
+    if (fclose(_out) != 0) _error = true;
+    _out = NULL;
+  }
+
+  return !_error;
+}
+
+uint64 CheckpointWriter::bytes(void) const
+{
+  return _bytes;
+}
+
+//------------------------------------------------------------------------------
+// CheckpointReader
+//
+CheckpointReader::CheckpointReader(const char *path)
+  : _in(fopen(path, "rb")), _error(false), _end(-1)
+{
+  if (_in == NULL) {
+    _error = true;
+    return;
+  }
+  setvbuf(_in, NULL, _IOFBF, CHECKPOINT_BUFFER);
+
+  char magic[8];
+  uint32 version;
+  if (!get(magic, sizeof(magic)) || !get(version) ||
+      (memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) ||
+      (version != CHECKPOINT_VERSION)) {
+    _error = true;
+  }
+}
+
+CheckpointReader::~CheckpointReader(void)
+{
+  if (_in != NULL) fclose(_in);
+}
+
+bool CheckpointReader::valid(void) const
+{
+  return !_error;
+}
+
+bool CheckpointReader::section(const char *tag)
+{
+  if ((_end >= 0) && !_error && (ftell(_in) != _end)) {
+    return fail("section size mismatch");
+  }
+
+  char t[4];
+  uint64 length;
+  if (!get(t, sizeof(t)) || !get(length)) return false;
+  if (memcmp(t, tag, sizeof(t)) != 0) return fail("unexpected section");
+  _end = ftell(_in) + length;
+
+  return true;
+}
+
+bool CheckpointReader::skip(const char *tag)
+{
+  if (!section(tag)) return false;
+  if (fseek(_in, _end, SEEK_SET) != 0) return fail("cannot skip section");
+
+  return true;
+}
+
+bool CheckpointReader::finish(void)
+{
+  if ((_end >= 0) && !_error && (ftell(_in) != _end)) {
+    return fail("section size mismatch");
+  }
+
+  return !_error;
+}
+
+bool CheckpointReader::get(void *p, size_t n)
+{
+  if (_error) return false;
+  if ((n > 0) && (fread(p, 1, n, _in) != n)) _error = true;
+
+  return !_error;
+}
+
+bool CheckpointReader::get_bool(bool &v)
+{
+  unsigned char b;
+  if (!get(b)) return false;
+  if (b > 1) return fail("corrupt flag");
+  v = b;
+
+  return true;
+}
+
+bool CheckpointReader::get_string(string &s)
+{
+  uint32 len;
+  if (!get(len)) return false;
+  if (len > CHECKPOINT_BUFFER) return fail("corrupt string");
+  s.resize(len);
+
+  return get(&s[0], len);
+}
+
+bool CheckpointReader::fail(const char *msg)
+{
+  if (!_error) cout << "Checkpoint: " << msg << "." << endl;
+  _error = true;
+
+  return false;
+}
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief checkpoint files of the simulator state
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_CHECKPOINT_H__
+#define __CA_CHECKPOINT_H__
+
+#include <cstdio>
+#include <string>
+
+#include "types.h"
+using namespace std;
+
+#define CHECKPOINT_MAGIC   "DLCKPT01"   ///< file magic (8 bytes)
+#define CHECKPOINT_VERSION 2            ///< format version
+#define CHECKPOINT_BUFFER  (1 << 20)    ///< stdio buffer size
+
+//------------------------------------------------------------------------------
+/// @brief checkpoint file format
+///
+///   header   magic "DLCKPT01", uint32 version
+///   section  4-byte tag, uint64 length of the data, data: the state of one
+///            component as saved by its save() method
+///
+/// Values are stored in the byte order and layout of the machine. Structures
+/// are written field by field so that no padding or pointer ends up in the
+/// file; bools are stored as one byte, 0 or 1. The integer arrays of the
+/// caches are written as they are in memory, so saving and restoring takes
+/// time proportional to the cache size. A checkpoint can only be
+/// restored by the same build on the same kind of machine. On restore,
+/// every component checks that it is configured as when it was saved, and
+/// the reader checks that each section was read completely.
+///
+
+//------------------------------------------------------------------------------
+/// @brief writer for checkpoint files
+///
+class CheckpointWriter {
+  public:
+    /// @brief constructor; writes the header. Check valid() before use.
+    /// @param path output file
+    CheckpointWriter(const char *path);
+
+    /// @brief destructor; calls close()
+    ~CheckpointWriter(void);
+
+    /// @brief true if the file could be opened and no write error occurred
+    bool valid(void) const;
+
+    /// @brief start section @a tag (4 characters); ends the previous one
+    void section(const char *tag);
+
+    /// @brief write @a n bytes at @a p
+    void put(const void *p, size_t n);
+
+    /// @brief write value @a v
+    template <class T>
+    void put(const T &v) { put(&v, sizeof(T)); }
+
+    /// @brief write the @a n elements of array @a p
+    template <class T>
+    void put_array(const T *p, size_t n) { put(p, n*sizeof(T)); }
+
+    /// @brief write bool @a v (one byte, 0 or 1)
+    void put_bool(bool v) { unsigned char b = v; put(b); }
+
+    /// @brief write string @a s (uint32 length and characters)
+    void put_string(const string &s);
+
+    /// @brief end the last section and close the file
+    /// @retval true on success
+    bool close(void);
+
+    /// @brief number of bytes written so far
+    uint64 bytes(void) const;
+
+  protected:
+    FILE  *_out;                    ///< output file
+    bool   _error;                  ///< a write failed
+    uint64 _bytes;                  ///< bytes written
+    long   _length;                 ///< offset of the length of the current
+                                    ///< section (-1: none)
+
+    /// @brief write the length of the current section
+    void end_section(void);
+
+  private:
+    CheckpointWriter(const CheckpointWriter&);
+    CheckpointWriter& operator=(const CheckpointWriter&);
+};
+
+//------------------------------------------------------------------------------
+/// @brief reader for checkpoint files
+///
+/// Reads past the end of the file or a wrong section tag put the reader
+/// into an error state; all further reads fail.
+///
+class CheckpointReader {
+  public:
+    /// @brief constructor; reads and checks the header. Check valid() before
+    ///        use.
+    /// @param path checkpoint file
+    CheckpointReader(const char *path);
+
+    /// @brief destructor
+    ~CheckpointReader(void);
+
+    /// @brief true if the header was valid and no read failed
+    bool valid(void) const;
+
+    /// @brief check that the previous section was read completely, read the
+    ///        tag of the next section and check that it is @a tag
+    /// @retval true on success
+    bool section(const char *tag);
+
+    /// @brief skip section @a tag
+    /// @retval true on success
+    bool skip(const char *tag);
+
+    /// @brief check that the last section was read completely
+    /// @retval true on success
+    bool finish(void);
+
+    /// @brief read @a n bytes into @a p
+    /// @retval true on success
+    bool get(void *p, size_t n);
+
+    /// @brief read value @a v
+    template <class T>
+    bool get(T &v) { return get(&v, sizeof(T)); }
+
+    /// @brief read @a n elements into array @a p
+    template <class T>
+    bool get_array(T *p, size_t n) { return get(p, n*sizeof(T)); }
+
+    /// @brief read a bool written by CheckpointWriter::put_bool(); fails on
+    ///        any other byte value
+    bool get_bool(bool &v);
+
+    /// @brief read a string written by CheckpointWriter::put_string()
+    bool get_string(string &s);
+
+    /// @brief put the reader into the error state and print @a msg
+    /// @retval false
+    bool fail(const char *msg);
+
+  protected:
+    FILE *_in;                      ///< input file
+    bool  _error;                   ///< a read failed
+    long  _end;                     ///< end of the current section (-1: none)
+
+  private:
+    CheckpointReader(const CheckpointReader&);
+    CheckpointReader& operator=(const CheckpointReader&);
+};
+
+#endif // __CA_CHECKPOINT_H__
@@ -35,6 +35,50 @@
 #define __CA_DISK_H__
 
 #include "types.h"
+#include "checkpoint.h"
+
+///@brief where the data of an access came from
+typedef enum {
+  ACCESS_DISK,                      ///< the platters (or flash)
+  ACCESS_CACHE,                     ///< the disk cache
+  ACCESS_BUFFER,                    ///< the track buffer
+  ACCESS_FLASH                      ///< a flash cache tier
+} AccessSource;
+
+///@brief latency breakdown of one access. The parts are the time charged
+///       for positioning and moving the data of the request itself; the
+///       latency of the access is their sum plus any flush stall.
+typedef struct DiskAccess {
+  double seek;                      ///< seek time
+  double rotation;                  ///< rotational latency
+  double transfer;                  ///< transfer time
+  uint32 tracks;                    ///< tracks crossed by the heads
+  AccessSource source;              ///< where the data came from
+} DiskAccess;
+
+/// @brief write access breakdown @a a to checkpoint @a out
+inline void save_access(CheckpointWriter &out, const DiskAccess &a)
+{
+  unsigned char source = a.source;
+  out.put(a.seek);
+  out.put(a.rotation);
+  out.put(a.transfer);
+  out.put(a.tracks);
+  out.put(source);
+}
+
+/// @brief read an access breakdown written by save_access() into @a a
+/// @retval true on success
+inline bool restore_access(CheckpointReader &in, DiskAccess &a)
+{
+  unsigned char source;
+  if (!in.get(a.seek) || !in.get(a.rotation) || !in.get(a.transfer) ||
+      !in.get(a.tracks) || !in.get(source)) return false;
+  if (source > ACCESS_FLASH) return in.fail("corrupt access source");
+  a.source = (AccessSource)source;
+
+  return true;
+}
 
 //------------------------------------------------------------------------------
 /// @brief base class for disk-based storage devices
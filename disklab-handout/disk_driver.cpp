@@ -32,67 +32,65 @@
 /// DAMAGE.
 //------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <string>
+#include <vector>
 #include <string.h>
 #include <libgen.h>
 
+#include "array.h"
 #include "disk.h"
 #include "hdd.h"
 #include "cache.h"
+#include "checkpoint.h"
+#include "merge.h"
+#include "mrc.h"
+#include "queue.h"
+#include "result.h"
+#include "setsim.h"
+#include "ssd.h"
+#include "sweep.h"
+#include "tier.h"
+#include "trace.h"
+#include "workload.h"
 using namespace std;
 
-/// @brief trim whitespace in string s at both ends
-///        Warning: modifies string in-place!
-/// @retval trimmed string
-static char* trim(char *s)
-{
-  if (s == NULL) return NULL;
-
-  //
-  // run through entire 0-terminated string and set
-  // - start: to the first non-whitespace character
-  // - end:   to the last non-whitespace character
-  //
-  char *start = NULL;
-  char *end = NULL;
-  char *p = s;
-
-  while (*p != '\0') {
-    bool white = (*p == ' ') || (*p == '\t');
-
-    if ((start == NULL) && !white) start = p;
-    if (!white) end = p;
-    p++;
-  }
-
-  //
-  // terminate string in-place
-  //
-  if (start == NULL) start = s;
-  if (end != NULL) *(++end) = '\0';
-  else *start = '\0';
-
-  return start;
-}
-
 /// @brief read disk configuration parameters from configuration file
 ///        and return HDD disk instance
 /// @param cfg path to configuration file
+/// @param policy cache replacement policy overriding the configuration file
+///        (NULL: use the configuration file or LRU)
+/// @param quiet do not print the disk parameters and ignore the verbose flag
 /// @retval HDD instance or NULL on failure
-HDD* create_disk(const char *cfg)
+HDD* create_disk(const char *cfg, const char *policy, bool quiet=false)
+{
+  HDD_Config c;
+  if (!HDD::read_config(cfg, policy, &c)) return NULL;
+
+  return HDD::create(c, quiet);
+}
+
+/// @brief read flash parameters from configuration file @a cfg and put a
+///        flash tier in front of @a hdd
+/// @param cfg path to SSD configuration file
+/// @param hdd disk (owned by the tier on success)
+/// @retval TieredDisk instance or NULL on failure
+TieredDisk* create_tier(const char *cfg, HDD *hdd)
 {
-  uint32 surfaces, tracks_per_surface, sectors_innermost, sectors_outermost,
-         rpm, bytes_per_sector, cache_size;
-  double seek_overhead, seek_per_track;
-  bool   verbose;
+  uint32 channels, dies, pages_per_block, page_size;
+  uint64 capacity;
+  double overprovision, t_read, t_program, t_erase, t_transfer;
 
   //
-  // open HDD configuration file
+  // open SSD configuration file
   //
   ifstream in(cfg);
   if (!in.good()) {
@@ -101,34 +99,67 @@ HDD* create_disk(const char *cfg)
   }
 
   //
-  // read HDD parameters
+  // read SSD parameters; the capacity is in MiB
   //
-  in >> surfaces;
-  in >> tracks_per_surface;
-  in >> sectors_innermost;
-  in >> sectors_outermost;
-  in >> rpm;
-  in >> bytes_per_sector;
-  in >> seek_overhead;
-  in >> seek_per_track;
-  in >> cache_size;
-  in >> verbose;
+  in >> channels;
+  in >> dies;
+  in >> pages_per_block;
+  in >> page_size;
+  in >> capacity;
+  in >> overprovision;
+  in >> t_read;
+  in >> t_program;
+  in >> t_erase;
+  in >> t_transfer;
 
   if (!in.good()) {
-    cout << "Error reading HDD parameters from configuration file." << endl;
+    cout << "Error reading SSD parameters from configuration file." << endl;
     return NULL;
   }
 
   //
-  // create new instance of HDD
+  // optional admission and eviction policy of the tier
   //
-  return new HDD(
-      surfaces, tracks_per_surface,
-      sectors_innermost, sectors_outermost,
-      rpm, bytes_per_sector,
-      seek_overhead, seek_per_track,
-      cache_size,
-      verbose);
+  string admission = "all", eviction = "lru";
+  if (in >> admission) in >> eviction;
+
+  uint32 bps = hdd->bytes_per_sector();
+  if ((channels == 0) || (dies == 0) || (pages_per_block == 0)) {
+    cout << "The SSD needs at least one channel, die and page per block."
+         << endl;
+    return NULL;
+  }
+  if ((page_size < bps) || (page_size % bps != 0)) {
+    cout << "The flash page size must be a multiple of the sector size ("
+         << bps << " bytes)." << endl;
+    return NULL;
+  }
+  if ((overprovision <= 0) || (overprovision > 1)) {
+    cout << "Invalid over-provisioning " << overprovision << "." << endl;
+    return NULL;
+  }
+  if ((double)(capacity << 20) / page_size * (1 + overprovision)
+      + (double)(SSD_GC_THRESHOLD + 2) * channels * dies * pages_per_block
+      >= 4e9) {
+    cout << "The SSD must have fewer than 4e9 pages." << endl;
+    return NULL;
+  }
+  if ((t_read < 0) || (t_program < 0) || (t_erase < 0) || (t_transfer < 0)) {
+    cout << "Invalid flash latencies." << endl;
+    return NULL;
+  }
+
+  //
+  // create the SSD and the tier
+  //
+  SSD *ssd = new SSD(channels, dies, pages_per_block, page_size, bps,
+                     capacity << 20, overprovision,
+                     t_read, t_program, t_erase, t_transfer);
+  TieredDisk *tier = TieredDisk::create(ssd, hdd, admission.c_str(),
+                                        eviction.c_str());
+  if (tier == NULL) delete ssd;
+
+  return tier;
 }
 
 /// @brief print usage information. Does not return (exit with @retstat)
@@ -138,12 +169,151 @@ void help(char *program, int retstat)
 {
   char *bn = basename(program);
   cout << "Usage: " << bn
-         << " -c/--config <CONFIG FILE> [-t/--trace <TRACE FILE>]" << endl
+         << " -c/--config <CONFIG FILE> [-t/--trace <TRACE FILE>]"
+         << " [-p/--policy <POLICY>]" << endl
+       << "         [-o/--output <MODE>] [-f/--output-file <FILE>]" << endl
+       << "         [-q/--queue-depth <DEPTH> [--scheduler <SCHEDULER>]]"
+         << " [--exact-rotation]" << endl
+       << "         [--readahead] [--track-buffer <SEGMENTS> "
+         << "[--zero-latency]]" << endl
+       << "         [--histogram <FILE>] [--top <K>] [--tier <SSD CONFIG>]"
+         << endl
+       << "         [--raid <LEVEL> --disks <N> [--stripe <BLOCKS>]]" << endl
+       << "         [--merge -t/--trace <TRACE FILE>[@<OPTIONS>]... "
+         << "[--tenant-stride <BYTES>]]" << endl
+       << "         [--checkpoint <FILE> [--checkpoint-at <REQUESTS> | "
+         << "--checkpoint-time <TS>]]" << endl
+       << "         [--restore <FILE>]" << endl
+       << "       " << bn << " -c/--config <CONFIG FILE> [-t/--trace <TRACE FILE>]"
+         << " -s/--setsim <THREADS>" << endl
+       << "       " << bn << " -c/--config <CONFIG FILE> [-t/--trace <TRACE FILE>]"
+         << " -m/--mrc <MAX SIZE>" << endl
+       << "         [--shards-rate <RATE> | --shards-size <BLOCKS>] "
+         << "[--mrc-check]" << endl
+       << "       " << bn << " --sweep -c/--config <CONFIG FILE>... "
+         << "-t/--trace <TRACE FILE>..." << endl
        << endl
        << "Run disk simulation on TRACE FILE using the HDD configuration "
        << "specified in CONFIG FILE." << endl
        << "While the configuration must be specified, the trace is optional"
        << " (trace read from stdin if no file given)." << endl
+       << "Binary traces created with traceconv and bzip2-compressed traces "
+       << "are detected" << endl
+       << "automatically; -j/--jobs <THREADS> sets the number of bzip2 "
+       << "decompression" << endl
+       << "threads (default: number of cores)." << endl
+       << "A TRACE FILE of the form gen:<key>=<value>,... generates a "
+       << "synthetic workload" << endl
+       << "instead, e.g. gen:pattern=zipf,theta=0.9,arrival=bursty,rate=200,"
+       << "count=1e9" << endl
+       << "(patterns uniform, zipf, seq; arrivals poisson, fixed, bursty; "
+       << "see workload.h)." << endl
+       << "With --sweep, every configuration is simulated on every trace "
+       << "on -j threads;" << endl
+       << "each trace is parsed once and shared by all configurations; "
+       << "--exact-rotation," << endl
+       << "--readahead and --track-buffer apply to every configuration."
+       << endl
+       << "With --merge, the traces are replayed together as tenants of one "
+       << "disk, merged" << endl
+       << "by timestamp while streaming; every trace starts at time 0. "
+       << "OPTIONS (see" << endl
+       << "merge.h) shift a tenant in time (offset=<SECONDS>), in the "
+       << "address space" << endl
+       << "(base=<BYTES>, default: tenant index x --tenant-stride) and "
+       << "scale its arrival" << endl
+       << "rate (scale=<FACTOR>). The summary lists the requests, response "
+       << "times and" << endl
+       << "throughput of every tenant. Up to " << MAX_TENANTS
+       << " traces can be merged, at most " << MAX_BZ2_TENANTS << endl
+       << "of them bzip2-compressed." << endl
+       << "With -q, requests queue in front of the disk: up to DEPTH (1.."
+       << MAX_QUEUE_DEPTH << ") requests" << endl
+       << "are held in the device queue and served in the order chosen by "
+       << "SCHEDULER" << endl
+       << "(fcfs, sstf, scan, clook, sptf; default: fcfs). Without -q, "
+       << "every request is" << endl
+       << "served as if the disk were idle." << endl
+       << "With --exact-rotation, the angular position of the platters is "
+       << "tracked and" << endl
+       << "every access waits exactly until its first sector comes around "
+       << "instead of" << endl
+       << "half a rotation on average. -q implies it, so that every "
+       << "scheduler is" << endl
+       << "simulated with the model that follows the head position." << endl
+       << "With --readahead, reads that continue one of up to "
+       << PREFETCH_STREAMS << " sequential streams" << endl
+       << "also read an adaptive window of the following blocks into the "
+       << "cache." << endl
+       << "With --track-buffer, the drive keeps the rest of every track it "
+       << "reads in one of" << endl
+       << "SEGMENTS (1.." << MAX_TRACK_SEGMENTS << ") buffer segments; "
+       << "--zero-latency reads whole tracks on arrival" << endl
+       << "of the heads and implies --exact-rotation." << endl
+       << "The summary reports the distribution of the response times "
+       << "(queueing delay" << endl
+       << "plus service time) of reads and writes; --histogram writes the "
+       << "non-empty" << endl
+       << "histogram buckets to FILE as CSV (op,from_ns,to_ns,count)." << endl
+       << "With --raid, the requests go to a RAID-0, 1 or 5 array of N disks "
+       << "of CONFIG FILE" << endl
+       << "with a stripe unit of BLOCKS blocks (default: 128); the disks "
+       << "are simulated in" << endl
+       << "parallel on -j threads where the requests allow it." << endl
+       << "With --tier, an SSD configured in SSD CONFIG caches the disk in "
+       << "units of flash" << endl
+       << "pages (see tier.h): channels, dies per channel, pages per block, "
+       << "page size," << endl
+       << "capacity in MiB, over-provisioning, page read, page program, "
+       << "block erase and" << endl
+       << "page transfer time, optionally followed by the admission policy "
+       << "(all, write," << endl
+       << "second; default: all) and the eviction policy (lru, fifo; "
+       << "default: lru)." << endl
+       << "--top lists the K slowest requests with the breakdown of their "
+       << "latency." << endl
+       << "--checkpoint saves the state of the disk, its cache, the "
+       << "statistics and the" << endl
+       << "position in the trace to FILE before the request number REQUESTS "
+       << "(counted" << endl
+       << "from 0) or the first request at or after timestamp TS, and ends "
+       << "the run there" << endl
+       << "(default: at the end of the trace). --restore continues a run "
+       << "from such a" << endl
+       << "checkpoint; the configuration, options and trace must be those "
+       << "of the saved" << endl
+       << "run. Neither can be combined with -q, --tier, --merge, --raid, "
+       << "--setsim, --mrc" << endl
+       << "or --sweep." << endl
+       << "MODE selects the per-request output: human (default), csv (one "
+       << "record per" << endl
+       << "request with the latency breakdown, to FILE if given), binary "
+       << "(the same as" << endl
+       << "fixed-size records, requires FILE) or summary (totals only). "
+       << "Only human" << endl
+       << "prints the disk parameters; when csv goes to stdout, the totals "
+       << "go to stderr." << endl
+       << "POLICY selects the cache replacement policy (lru, clock, 2q, arc, "
+       << "lirs) and" << endl
+       << "overrides the optional policy in the configuration file "
+       << "(default: lru)." << endl
+       << "The policy in the configuration file may be followed by the "
+       << "write policy, wt" << endl
+       << "(write-through, default) or wb (write-back), and the fraction of "
+       << "the cache" << endl
+       << "that may hold dirty blocks before writes stall (default: 0.5)."
+       << endl
+       << "Set-associative caches: sa4, sa8, sa16. With --setsim, only the "
+       << "cache is" << endl
+       << "simulated, partitioned by set index on THREADS threads." << endl
+       << "With --mrc, the LRU miss rate of every cache size up to MAX SIZE "
+       << "(2.." << MAX_MRC_SIZE << ") blocks is" << endl
+       << "computed in one pass over the trace. --shards-rate <RATE> estimates "
+       << "it from" << endl
+       << "a spatial sample of the blocks, --shards-size <BLOCKS> with at most "
+       << "BLOCKS" << endl
+       << "sampled blocks; --mrc-check compares the estimate with the exact "
+       << "curve." << endl
        << endl
        << "Example: " << bn << " -c hdd.16tb.cfg -t trace.dat" << endl
        << endl;
@@ -151,40 +321,977 @@ void help(char *program, int retstat)
   exit(retstat);
 }
 
+///@brief command line options
+typedef struct Options {
+  char  *cfg;                       ///< path to configuration file
+  char  *trace;                     ///< path to trace file (NULL: stdin)
+  vector<char*> cfgs;               ///< all configuration files (--sweep)
+  vector<char*> traces;             ///< all trace files (--sweep)
+  bool   sweep;                     ///< --sweep: all configs x all traces
+  char  *policy;                    ///< cache policy (NULL: from config)
+  uint32 threads;                   ///< --setsim threads (0: off)
+  uint32 mrc;                       ///< --mrc maximum cache size (0: off)
+  double shards_rate;               ///< --shards-rate (0: exact MRC)
+  uint32 shards_size;               ///< --shards-size (0: fixed rate)
+  bool   mrc_check;                 ///< --mrc-check: compare with exact MRC
+  uint32 jobs;                      ///< -j: decompression threads (0: all)
+  char  *output;                    ///< output mode (human, csv, summary)
+  char  *output_file;               ///< output file (NULL: stdout)
+  uint32 queue;                     ///< -q: device queue depth (0: off)
+  char  *scheduler;                 ///< --scheduler (NULL: fcfs)
+  bool   exact_rotation;            ///< --exact-rotation: track the platters
+  bool   readahead;                 ///< --readahead: sequential prefetching
+  uint32 track_buffer;              ///< --track-buffer segments (0: off)
+  bool   zero_latency;              ///< --zero-latency: read-on-arrival
+  char  *histogram;                 ///< --histogram output file (NULL: off)
+  uint32 top;                       ///< --top: slowest requests listed
+  int    raid;                      ///< --raid level (-1: single disk)
+  uint32 disks;                     ///< --disks: array members
+  uint32 stripe;                    ///< --stripe: stripe unit in blocks
+  char  *tier;                      ///< --tier SSD configuration (NULL: off)
+  bool   merge;                     ///< --merge: replay traces as tenants
+  uint64 tenant_stride;             ///< --tenant-stride: default tenant base
+  char  *checkpoint;                ///< --checkpoint file (NULL: off)
+  uint64 checkpoint_at;             ///< --checkpoint-at request number
+  double checkpoint_time;           ///< --checkpoint-time timestamp
+  char  *restore;                   ///< --restore file (NULL: off)
+} Options;
+
+/// @brief parse a numeric option argument or exit with an error
+/// @param program program name (argv[0])
+/// @param opt option name
+/// @param arg option argument
+/// @param min smallest allowed value
+/// @param max largest allowed value
+/// @param integer only accept whole numbers
+/// @retval value of @a arg
+static double numeric_argument(char *program, const char *opt, const char *arg,
+                               double min, double max, bool integer=true)
+{
+  char *end;
+  double v = strtod(arg, &end);
+
+  if ((*end != '\0') || (end == arg) || (v < min) || (v > max) ||
+      (integer && (v != floor(v)))) {
+    cout << "Error: invalid argument '" << arg << "' for " << opt << "."
+      << endl;
+    help(program, EXIT_FAILURE);
+  }
+
+  return v;
+}
+
 /// @brief parse command line arguments
 /// @param argc number of command line parameters
 /// @param argv array containing command line parameters
-/// @param cfg [output] pointer to character array to hold path to config. file
-/// @param trace [output] pointer to character array to hold path to trace file
-void parse_arguments(int argc, char *argv[], char **cfg, char **trace)
+/// @param opt [output] parsed options
+void parse_arguments(int argc, char *argv[], Options *opt)
 {
-  int i;
-  *cfg = *trace = NULL;
+  int i = 1;
+  opt->cfg = opt->trace = opt->policy = opt->output_file = NULL;
+  opt->scheduler = opt->histogram = opt->tier = NULL;
+  opt->checkpoint = opt->restore = NULL;
+  opt->checkpoint_at = numeric_limits<uint64>::max();
+  opt->checkpoint_time = numeric_limits<double>::infinity();
+  opt->output = (char*)"human";
+  opt->threads = opt->mrc = opt->shards_size = opt->jobs = opt->queue = 0;
+  opt->track_buffer = opt->top = opt->disks = 0;
+  opt->raid = -1;
+  opt->stripe = 128;
+  opt->merge = false;
+  opt->tenant_stride = 0;
+  opt->zero_latency = false;
+  opt->shards_rate = 0.0;
+  opt->mrc_check = opt->sweep = opt->exact_rotation = opt->readahead = false;
 
   while (i < argc) {
     if ((strcmp(argv[i], "-c") == 0) || (strcmp(argv[i], "--config") == 0)) {
       i++;
-      *cfg = argv[i];
+      if (i < argc) opt->cfg = argv[i];
+      while ((i < argc) && (argv[i][0] != '-')) opt->cfgs.push_back(argv[i++]);
+      i--;
     } else
     if ((strcmp(argv[i], "-t") == 0) || (strcmp(argv[i], "--trace") == 0)) {
       i++;
-      *trace = argv[i];
+      if (i < argc) opt->trace = argv[i];
+      while ((i < argc) && (argv[i][0] != '-')) opt->traces.push_back(argv[i++]);
+      i--;
+    } else
+    if ((strcmp(argv[i], "-q") == 0) ||
+        (strcmp(argv[i], "--queue-depth") == 0)) {
+      i++;
+      if (i < argc) {
+        opt->queue = numeric_argument(argv[0], argv[i-1], argv[i], 1,
+                                      MAX_QUEUE_DEPTH);
+      }
+    } else
+    if (strcmp(argv[i], "--scheduler") == 0) {
+      i++;
+      opt->scheduler = argv[i];
+    } else
+    if (strcmp(argv[i], "--exact-rotation") == 0) {
+      opt->exact_rotation = true;
+    } else
+    if (strcmp(argv[i], "--readahead") == 0) {
+      opt->readahead = true;
+    } else
+    if (strcmp(argv[i], "--track-buffer") == 0) {
+      i++;
+      if (i < argc) {
+        opt->track_buffer = numeric_argument(argv[0], argv[i-1], argv[i], 1,
+                                             MAX_TRACK_SEGMENTS);
+      }
+    } else
+    if (strcmp(argv[i], "--zero-latency") == 0) {
+      opt->zero_latency = true;
+    } else
+    if (strcmp(argv[i], "--histogram") == 0) {
+      i++;
+      opt->histogram = argv[i];
+    } else
+    if (strcmp(argv[i], "--raid") == 0) {
+      i++;
+      if (i < argc) {
+        opt->raid = numeric_argument(argv[0], argv[i-1], argv[i], 0, 5);
+      }
+    } else
+    if (strcmp(argv[i], "--disks") == 0) {
+      i++;
+      if (i < argc) {
+        opt->disks = numeric_argument(argv[0], argv[i-1], argv[i], 1,
+                                      MAX_ARRAY_DISKS);
+      }
+    } else
+    if (strcmp(argv[i], "--stripe") == 0) {
+      i++;
+      if (i < argc) {
+        opt->stripe = numeric_argument(argv[0], argv[i-1], argv[i], 1, 1e9);
+      }
+    } else
+    if (strcmp(argv[i], "--merge") == 0) {
+      opt->merge = true;
+    } else
+    if (strcmp(argv[i], "--tenant-stride") == 0) {
+      i++;
+      double d;
+      if ((i < argc) &&
+          (!parse_number(argv[i], &d) || (d < 0) || (d != floor(d)))) {
+        cout << "Error: invalid argument '" << argv[i] << "' for "
+             << argv[i-1] << "." << endl;
+        help(argv[0], EXIT_FAILURE);
+      }
+      if (i < argc) opt->tenant_stride = (uint64)d;
+    } else
+    if (strcmp(argv[i], "--tier") == 0) {
+      i++;
+      opt->tier = argv[i];
+    } else
+    if (strcmp(argv[i], "--checkpoint") == 0) {
+      i++;
+      opt->checkpoint = argv[i];
+    } else
+    if (strcmp(argv[i], "--checkpoint-at") == 0) {
+      i++;
+      if (i < argc) {
+        opt->checkpoint_at = numeric_argument(argv[0], argv[i-1], argv[i], 0,
+                                              1e18);
+      }
+    } else
+    if (strcmp(argv[i], "--checkpoint-time") == 0) {
+      i++;
+      if (i < argc) {
+        opt->checkpoint_time = numeric_argument(argv[0], argv[i-1], argv[i],
+                                                -1e300, 1e300, false);
+      }
+    } else
+    if (strcmp(argv[i], "--restore") == 0) {
+      i++;
+      opt->restore = argv[i];
+    } else
+    if (strcmp(argv[i], "--top") == 0) {
+      i++;
+      if (i < argc) {
+        opt->top = numeric_argument(argv[0], argv[i-1], argv[i], 1, 1e6);
+      }
+    } else
+    if (strcmp(argv[i], "--sweep") == 0) {
+      opt->sweep = true;
+    } else
+    if ((strcmp(argv[i], "-p") == 0) || (strcmp(argv[i], "--policy") == 0)) {
+      i++;
+      opt->policy = argv[i];
+    } else
+    if ((strcmp(argv[i], "-s") == 0) || (strcmp(argv[i], "--setsim") == 0)) {
+      i++;
+      if (i < argc) {
+        opt->threads = numeric_argument(argv[0], argv[i-1], argv[i], 1, 4096);
+      }
+    } else
+    if ((strcmp(argv[i], "-m") == 0) || (strcmp(argv[i], "--mrc") == 0)) {
+      i++;
+      if (i < argc) {
+        opt->mrc = numeric_argument(argv[0], argv[i-1], argv[i], 2,
+                                    MAX_MRC_SIZE);
+      }
+    } else
+    if (strcmp(argv[i], "--shards-rate") == 0) {
+      i++;
+      if (i < argc) {
+        opt->shards_rate = numeric_argument(argv[0], argv[i-1], argv[i],
+                                            1e-6, 1, false);
+      }
+    } else
+    if (strcmp(argv[i], "--shards-size") == 0) {
+      i++;
+      if (i < argc) {
+        opt->shards_size = numeric_argument(argv[0], argv[i-1], argv[i],
+                                            1, 4e9);
+      }
+    } else
+    if (strcmp(argv[i], "--mrc-check") == 0) {
+      opt->mrc_check = true;
+    } else
+    if ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "--output") == 0)) {
+      i++;
+      opt->output = argv[i];
+    } else
+    if ((strcmp(argv[i], "-f") == 0) ||
+        (strcmp(argv[i], "--output-file") == 0)) {
+      i++;
+      opt->output_file = argv[i];
+    } else
+    if ((strcmp(argv[i], "-j") == 0) || (strcmp(argv[i], "--jobs") == 0)) {
+      i++;
+      if (i < argc) {
+        opt->jobs = numeric_argument(argv[0], argv[i-1], argv[i], 1, 4096);
+      }
     } else
     if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
       help(argv[0], EXIT_SUCCESS);
     }
     if (i == argc) {
-      cout << "Error: missing filename after " << argv[i-1] << " argument."
+      cout << "Error: missing argument after " << argv[i-1] << "."
         << endl;
       help(argv[0], EXIT_FAILURE);
     }
     i++;
   }
 
-  if (*cfg == NULL) {
+  if (opt->cfg == NULL) {
     cout << "Error: missing configuration file." << endl;
     help(argv[0], EXIT_FAILURE);
   }
+
+  if (!opt->sweep && (opt->cfgs.size() > 1)) {
+    cout << "Error: multiple configurations require --sweep." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (!opt->sweep && !opt->merge && (opt->traces.size() > 1)) {
+    cout << "Error: multiple traces require --sweep or --merge." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (opt->merge) {
+    if (opt->traces.empty() || opt->sweep) {
+      cout << "Error: --merge requires trace files and cannot be combined "
+           << "with --sweep." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+  } else if (opt->tenant_stride > 0) {
+    cout << "Error: --tenant-stride requires --merge." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (opt->sweep && opt->traces.empty()) {
+    cout << "Error: --sweep requires trace files." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (opt->sweep &&
+      ((opt->queue > 0) || (opt->threads > 0) || (opt->mrc > 0) ||
+       (opt->top > 0) || (opt->histogram != NULL) ||
+       (opt->output_file != NULL) || (strcmp(opt->output, "human") != 0))) {
+    cout << "Error: --sweep cannot be combined with -q, --setsim, --mrc, "
+         << "--top, --histogram," << endl
+         << "-o or -f." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (opt->scheduler != NULL) {
+    if (!DiskScheduler::is_scheduler(opt->scheduler)) {
+      cout << "Error: unknown scheduler '" << opt->scheduler << "'." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+    if (opt->queue == 0) {
+      cout << "Error: --scheduler requires -q/--queue-depth." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+  }
+
+  // the schedulers other than fcfs rank requests by the track the heads are
+  // on, which only the exact model follows (SPTF also by the rotational
+  // position); fcfs uses the same model so that the schedulers compare
+  if (opt->queue > 0) opt->exact_rotation = true;
+
+  if (opt->zero_latency) {
+    if (opt->track_buffer == 0) {
+      cout << "Error: --zero-latency requires --track-buffer." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+    // read-on-arrival depends on where the heads land on the track
+    opt->exact_rotation = true;
+  }
+
+  if (opt->raid >= 0) {
+    if (opt->disks == 0) {
+      cout << "Error: --raid requires --disks." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+    if ((opt->queue > 0) || (opt->threads > 0) || (opt->mrc > 0) ||
+        opt->sweep) {
+      cout << "Error: --raid cannot be combined with -q, --setsim, --mrc or "
+           << "--sweep." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+  } else if (opt->disks > 0) {
+    cout << "Error: --disks requires --raid." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if ((opt->tier != NULL) &&
+      ((opt->raid >= 0) || (opt->queue > 0) || (opt->threads > 0) ||
+       (opt->mrc > 0) || opt->sweep)) {
+    cout << "Error: --tier cannot be combined with --raid, -q, --setsim, "
+         << "--mrc or --sweep." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  bool at = opt->checkpoint_at != numeric_limits<uint64>::max();
+  bool time = !isinf(opt->checkpoint_time);
+  if ((at || time) && (opt->checkpoint == NULL)) {
+    cout << "Error: --checkpoint-at and --checkpoint-time require "
+         << "--checkpoint." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+  if (at && time) {
+    cout << "Error: --checkpoint-at and --checkpoint-time cannot be "
+         << "combined." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (((opt->checkpoint != NULL) || (opt->restore != NULL)) &&
+      ((opt->queue > 0) || (opt->tier != NULL) || opt->merge ||
+       (opt->raid >= 0) || (opt->threads > 0) || (opt->mrc > 0) ||
+       opt->sweep)) {
+    cout << "Error: --checkpoint and --restore cannot be combined with -q, "
+         << "--tier, --merge," << endl
+         << "--raid, --setsim, --mrc or --sweep." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (!ResultSink::is_mode(opt->output)) {
+    cout << "Error: unknown output mode '" << opt->output << "'." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if ((strcmp(opt->output, "binary") == 0) && (opt->output_file == NULL)) {
+    cout << "Error: -o binary requires -f/--output-file." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (((opt->shards_rate > 0) || (opt->shards_size > 0) || opt->mrc_check)
+      && (opt->mrc == 0)) {
+    cout << "Error: --shards-rate, --shards-size and --mrc-check require "
+      << "--mrc." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+}
+
+/// @brief apply the disk options of @a opt (--exact-rotation, --readahead,
+///        --track-buffer) to @a hdd
+static void setup_disk(HDD *hdd, const Options &opt)
+{
+  hdd->track_rotation(opt.exact_rotation);
+  hdd->readahead(opt.readahead);
+  hdd->track_buffer(opt.track_buffer, opt.zero_latency);
+}
+
+/// @brief offline set-partitioned simulation of the HDD's cache. Reads the
+///        trace into memory and replays reads as get, writes as put requests.
+/// @param hdd HDD instance (defines the cache and the block size)
+/// @param in input trace
+/// @param threads number of threads
+/// @retval EXIT_SUCCESS or EXIT_FAILURE
+int run_setsim(HDD *hdd, TraceReader *in, uint32 threads)
+{
+  const BlockCache *cache = hdd->cache();
+  if ((cache == NULL) || (BlockCache::ways(cache->policy()) == 0)) {
+    cout << "Error: --setsim requires a set-associative cache (sa4, sa8, "
+         << "sa16)." << endl;
+    return EXIT_FAILURE;
+  }
+
+  TraceRequest t;
+  uint32 bps = hdd->bytes_per_sector();
+  uint64 hits, misses;
+  vector<CacheRequest> stream;
+
+  while (in->next(&t)) {
+    CacheRequest r = { t.address / bps, (t.length + bps-1) / bps, t.rw == 'r' };
+    stream.push_back(r);
+  }
+  if (in->failed()) return EXIT_FAILURE;
+
+  setsim(cache->policy(), cache->size(), stream, threads, &hits, &misses);
+
+  cout.precision(3);
+  cout << fixed << "set-partitioned simulation of " << stream.size() << " requests ("
+       << threads << " threads):" << endl
+       << "  cache (" << cache->size() << " blocks, " << cache->policy()
+       << "): " << hits << " hits, " << misses << " misses, miss rate: "
+       << (hits+misses > 0 ? (double)misses/(hits+misses)*100 : 0.0) << "%"
+       << endl << endl;
+
+  return EXIT_SUCCESS;
+}
+
+/// @brief compute the LRU miss-ratio curve of the trace in one pass. Reads
+///        count as hits/misses, writes only update recency (as in HDD).
+///        With a sampling rate or size, the curve is estimated with SHARDS;
+///        @a opt.mrc_check additionally compares it to the exact curve.
+/// @param hdd HDD instance (defines the block size)
+/// @param in input trace
+/// @param opt options (mrc, shards_rate, shards_size, mrc_check)
+/// @retval EXIT_SUCCESS or EXIT_FAILURE
+int run_mrc(HDD *hdd, TraceReader *in, const Options &opt)
+{
+  TraceRequest t;
+  uint32 bps = hdd->bytes_per_sector(), max_size = opt.mrc;
+  uint64 requests = 0;
+  bool sampled = (opt.shards_rate > 0) || (opt.shards_size > 0);
+  bool exact = !sampled || opt.mrc_check;
+  StackDistance *sd = exact ? new StackDistance(max_size) : NULL;
+  ShardsMRC *shards = NULL;
+
+  if (sampled) {
+    shards = new ShardsMRC(max_size,
+                           opt.shards_rate > 0 ? opt.shards_rate : 1.0,
+                           opt.shards_size);
+  }
+
+  while (in->next(&t)) {
+    uint64 block = t.address / bps;
+    uint64 nblocks = (t.length + bps-1) / bps;
+
+    for (uint64 b=block; b<block+nblocks; b++) {
+      if (sd != NULL) sd->access(b, t.rw == 'r');
+      if (shards != NULL) shards->access(b, t.rw == 'r');
+    }
+    requests++;
+  }
+  if (in->failed()) {
+    delete sd;
+    delete shards;
+    return EXIT_FAILURE;
+  }
+
+  vector<uint64> misses;
+  vector<double> est, err;
+  if (sd != NULL) sd->curve(misses);
+  if (shards != NULL) shards->curve(est, err);
+
+  cout << "LRU miss-ratio curve of " << requests << " requests";
+  if (sd != NULL) {
+    cout << " (" << sd->accesses() << " block reads, " << sd->distinct()
+         << " distinct blocks)";
+  }
+  cout << ":" << endl;
+  if (shards != NULL) {
+    cout.precision(6);
+    cout << "  SHARDS sampling rate " << fixed << shards->rate();
+    if (opt.shards_size > 0) {
+      cout << " (fixed size: " << shards->samples() << " / "
+           << opt.shards_size << " blocks tracked)";
+    }
+    cout << endl;
+  }
+
+  cout << setw(12) << "cache size";
+  if (sd != NULL) cout << setw(16) << "misses" << setw(12) << "miss rate";
+  if (shards != NULL) cout << setw(12) << "estimate" << setw(10) << "+/-";
+  if ((sd != NULL) && (shards != NULL)) cout << setw(10) << "abs.err";
+  cout << endl;
+
+  double sum_err = 0, max_err = 0;
+  cout.precision(3);
+  for (uint32 c=2; c<=max_size; c++) {
+    double exact_rate = 0;
+    cout << setw(12) << c << fixed;
+    if (sd != NULL) {
+      exact_rate = sd->accesses() > 0 ? (double)misses[c]/sd->accesses() : 0;
+      cout << setw(16) << misses[c] << setw(11) << exact_rate*100 << "%";
+    }
+    if (shards != NULL) {
+      cout << setw(11) << est[c]*100 << "%";
+      if (err[c] < 0) cout << setw(10) << "n/a";
+      else cout << setw(9) << err[c]*100 << "%";
+    }
+    if ((sd != NULL) && (shards != NULL)) {
+      double e = fabs(est[c] - exact_rate);
+      sum_err += e;
+      if (e > max_err) max_err = e;
+      cout << setw(9) << e*100 << "%";
+    }
+    cout << endl;
+  }
+  if ((shards != NULL) && (err[2] < 0)) {
+    cout << "n/a: cache sizes below 1/R = " << 1.0/shards->rate()
+         << " blocks are below the sampling resolution;" << endl
+         << "     the estimate is unreliable there." << endl;
+  }
+  if ((sd != NULL) && (shards != NULL)) {
+    cout << "mean absolute error: " << sum_err/(max_size-1)*100
+         << "%, max. absolute error: " << max_err*100 << "%" << endl;
+  }
+  cout << endl;
+
+  delete sd;
+  delete shards;
+
+  return EXIT_SUCCESS;
+}
+
+/// @brief print the response time distribution @a h of operation @a op
+static void print_latency(const char *op, const LatencyHistogram &h)
+{
+  if (h.count() == 0) return;
+
+  cout.precision(3);
+  cout << "  " << op << " latency [ms]: min " << h.min()*1000
+       << ", mean " << h.mean()*1000 << ", p50 " << h.percentile(50)*1000
+       << ", p90 " << h.percentile(90)*1000 << endl
+       << "    p99 " << h.percentile(99)*1000
+       << ", p99.9 " << h.percentile(99.9)*1000 << ", max " << h.max()*1000
+       << " (" << h.count() << " requests)" << endl;
+}
+
+/// @brief open the trace, or merge the traces of all tenants (--merge)
+/// @param opt options
+/// @param merged (output) the merged reader, NULL without --merge
+/// @retval TraceReader instance or NULL on failure
+static TraceReader* open_trace(const Options &opt, MergedTraceReader **merged)
+{
+  *merged = NULL;
+  if (!opt.merge) return TraceReader::open(opt.trace, opt.jobs);
+
+  *merged = MergedTraceReader::open(opt.traces, opt.tenant_stride, opt.jobs);
+  return *merged;
+}
+
+/// @brief list the requests, response times and throughput of the tenants
+///        of @a merged as recorded by @a sink
+static void print_tenants(const ResultSink *sink,
+                          const MergedTraceReader *merged)
+{
+  const vector<TenantStats> &ten = sink->tenants();
+  if ((merged == NULL) || ten.empty()) return;
+
+  double first = 0, last = 0;
+  uint64 n = 0;
+  for (size_t t=0; t<ten.size(); t++) {
+    uint64 req = ten[t].reads + ten[t].writes;
+    if (req == 0) continue;
+    if ((n == 0) || (ten[t].first < first)) first = ten[t].first;
+    if ((n == 0) || (ten[t].last > last)) last = ten[t].last;
+    n += req;
+  }
+
+  cout.precision(3);
+  cout << "  " << ten.size() << " tenants: aggregate throughput: "
+       << (last > first ? n/(last - first) : 0) << " requests/s over "
+       << last - first << " s" << endl
+       << setw(8) << "tenant" << setw(10) << "requests" << setw(9) << "reads"
+       << setw(9) << "writes" << setw(13) << "mean [ms]" << setw(13)
+       << "p99 [ms]" << setw(13) << "p99.9 [ms]" << setw(11) << "[req/s]"
+       << "  trace" << endl;
+  for (size_t t=0; t<ten.size(); t++) {
+    const TenantStats &s = ten[t];
+    double span = s.last - s.first;
+    cout << setw(8) << t << setw(10) << s.reads + s.writes
+         << setw(9) << s.reads << setw(9) << s.writes
+         << setw(13) << s.latency.mean()*1000
+         << setw(13) << s.latency.percentile(99)*1000
+         << setw(13) << s.latency.percentile(99.9)*1000
+         << setw(11) << (span > 0 ? (s.reads + s.writes)/span : 0)
+         << "  " << merged->name(t) << endl;
+  }
+}
+
+/// @brief list the slowest requests kept by @a sink with their latency
+///        breakdown
+static void print_slowest(const ResultSink *sink)
+{
+  static const char *source[] = { "disk", "cache", "buffer", "flash" };
+  vector<ResultRecord> top;
+
+  sink->slowest().sorted(top);
+  if (top.empty()) return;
+
+  cout.precision(3);
+  cout << "  " << top.size() << " slowest requests [ms]:" << endl
+       << setw(6) << "rank" << setw(18) << "ts" << setw(4) << "op"
+       << setw(12) << "block" << setw(7) << "blocks" << setw(11) << "response"
+       << setw(10) << "queue" << setw(10) << "stall" << setw(10) << "seek"
+       << setw(10) << "rotation" << setw(10) << "transfer" << setw(8)
+       << "tracks" << setw(8) << "source" << endl;
+  for (size_t i=0; i<top.size(); i++) {
+    const ResultRecord &r = top[i];
+    cout << setw(6) << i+1 << setw(18) << r.ts << setw(4) << r.rw
+         << setw(12) << r.block << setw(7) << r.nblocks
+         << setw(11) << (r.latency + r.queue)*1000
+         << setw(10) << r.queue*1000 << setw(10) << r.stall*1000
+         << setw(10) << r.access.seek*1000
+         << setw(10) << r.access.rotation*1000
+         << setw(10) << r.access.transfer*1000
+         << setw(8) << r.access.tracks
+         << setw(8) << source[r.access.source] << endl;
+  }
+}
+
+/// @brief write the read and write latency histograms of @a sink to @a path
+/// @retval true on success
+static bool dump_histograms(const ResultSink *sink, const char *path)
+{
+  ofstream out(path);
+  if (!out.good()) {
+    cout << "Cannot open histogram file '" << path << "'." << endl;
+    return false;
+  }
+
+  out << "op,from_ns,to_ns,count" << endl;
+  sink->latency('r').dump(out, "read");
+  sink->latency('w').dump(out, "write");
+
+  if (!out.good()) {
+    cout << "Error writing histogram file '" << path << "'." << endl;
+    return false;
+  }
+  return true;
+}
+
+/// @brief progress of the simulation loop
+typedef struct RunState {
+  uint64 requests;                  ///< requests read from the trace
+  uint32 rop;                       ///< number of reads
+  uint32 wop;                       ///< number of writes
+  double t_tot;                     ///< sum of latencies
+  double t_wr;                      ///< sum of write latencies
+} RunState;
+
+/// @brief save the state of the run to checkpoint file @a path: the loop
+///        state @a run on trace @a trace, then the disk and the sink
+/// @retval true on success
+static bool save_checkpoint(const char *path, const RunState &run,
+                            const char *trace, const HDD *hdd,
+                            const ResultSink *sink)
+{
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  CheckpointWriter out(path);
+
+  out.section("RUN ");
+  out.put(run);
+  out.put_string(trace != NULL ? trace : "");
+  hdd->save(out);
+  sink->save(out);
+
+  uint64 bytes = out.bytes();
+  if (!out.close()) {
+    cout << "Error writing checkpoint file '" << path << "'." << endl;
+    return false;
+  }
+
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now()
+                                            - start).count();
+  cout.precision(3);
+  cout << "checkpoint after " << run.requests << " requests written to '"
+       << path << "' (" << bytes << " bytes, " << elapsed*1000 << " ms)"
+       << endl;
+
+  return true;
+}
+
+/// @brief restore the state of a run from checkpoint file @a path into
+///        @a run, @a hdd and @a sink and skip the requests of trace @a in
+///        that were simulated before it was saved
+/// @retval true on success
+static bool restore_checkpoint(const char *path, RunState *run,
+                               const char *trace, TraceReader *in, HDD *hdd,
+                               ResultSink *sink)
+{
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  CheckpointReader ckpt(path);
+  string saved;
+
+  bool ok = ckpt.valid() && ckpt.section("RUN ") && ckpt.get(*run) &&
+            ckpt.get_string(saved);
+  if (ok && (saved != (trace != NULL ? trace : ""))) {
+    ok = ckpt.fail("the trace differs");
+  }
+  ok = ok && hdd->restore(ckpt) && sink->restore(ckpt) && ckpt.finish();
+  if (ok && (in->skip(run->requests) != run->requests)) {
+    ok = ckpt.fail("the trace is shorter than the checkpoint");
+  }
+  if (!ok) {
+    cout << "Cannot restore checkpoint file '" << path << "'." << endl;
+    return false;
+  }
+
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now()
+                                            - start).count();
+  cout.precision(3);
+  cout << "restored " << run->requests << " requests from '" << path
+       << "' (" << elapsed*1000 << " ms)" << endl;
+
+  return true;
+}
+
+/// @brief simulate all configurations on all traces and print a table
+/// @param opt options (cfgs, traces, policy, jobs and the disk options)
+/// @retval EXIT_SUCCESS or EXIT_FAILURE
+int run_sweep(const Options &opt)
+{
+  //
+  // check the configurations before starting
+  //
+  for (size_t c=0; c<opt.cfgs.size(); c++) {
+    HDD *hdd = create_disk(opt.cfgs[c], opt.policy, true);
+    if (hdd == NULL) return EXIT_FAILURE;
+    delete hdd;
+  }
+
+  vector<vector<SweepResult> > result;
+  uint64 steals;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  sweep(opt.cfgs.size(),
+        [&opt](uint32 c) {
+          HDD *hdd = create_disk(opt.cfgs[c], opt.policy, true);
+          if (hdd != NULL) setup_disk(hdd, opt);
+          return hdd;
+        },
+        opt.traces, opt.jobs, result, &steals);
+
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now()
+                                            - start).count();
+
+  //
+  // print table
+  //
+  size_t wc = 6, wt = 5;
+  for (size_t c=0; c<opt.cfgs.size(); c++) wc = max(wc, strlen(opt.cfgs[c]));
+  for (size_t t=0; t<opt.traces.size(); t++) {
+    wt = max(wt, strlen(opt.traces[t]));
+  }
+
+  cout << "sweep of " << opt.cfgs.size() << " configurations x "
+       << opt.traces.size() << " traces:" << endl
+       << left << setw(wc+2) << "config" << setw(wt+2) << "trace" << right
+       << setw(10) << "requests" << setw(16) << "total time"
+       << setw(12) << "hits" << setw(12) << "misses" << setw(11) << "miss rate"
+       << setw(10) << "p99 [ms]" << setw(12) << "p99.9 [ms]"
+       << setw(10) << "sim. [s]" << endl;
+
+  int res = EXIT_SUCCESS;
+  for (size_t c=0; c<opt.cfgs.size(); c++) {
+    LatencyHistogram all;
+    for (size_t t=0; t<opt.traces.size(); t++) {
+      const SweepResult &r = result[c][t];
+      cout << left << setw(wc+2) << opt.cfgs[c] << setw(wt+2)
+           << opt.traces[t] << right;
+      if (!r.ok) {
+        cout << "  failed" << endl;
+        res = EXIT_FAILURE;
+        continue;
+      }
+      uint64 acc = r.hits + r.misses;
+      cout << fixed << setw(10) << r.reads + r.writes
+           << setprecision(7) << setw(16) << r.time
+           << setw(12) << r.hits << setw(12) << r.misses
+           << setprecision(3) << setw(10)
+           << (acc > 0 ? (double)r.misses/acc*100 : 0.0) << "%"
+           << setw(10) << r.latency.percentile(99)*1000
+           << setw(12) << r.latency.percentile(99.9)*1000
+           << setw(10) << r.seconds << endl;
+      all.merge(r.latency);
+    }
+
+    // response time distribution of the configuration over all traces
+    if ((opt.traces.size() > 1) && (all.count() > 0)) {
+      cout << left << setw(wc+2) << opt.cfgs[c] << setw(wt+2) << "(all)"
+           << right << setw(10) << all.count() << setw(16) << "" << setw(12)
+           << "" << setw(12) << "" << setw(11) << "" << setprecision(3)
+           << setw(10) << all.percentile(99)*1000
+           << setw(12) << all.percentile(99.9)*1000 << endl;
+    }
+  }
+  cout << "elapsed: " << setprecision(3) << elapsed << " s, "
+       << steals << " tasks stolen" << endl << endl;
+
+  return res;
+}
+
+/// @brief simulate the trace on a disk array (--raid)
+/// @param opt options
+/// @retval EXIT_SUCCESS or EXIT_FAILURE
+int run_array(const Options &opt)
+{
+  //
+  // create the members and the array
+  //
+  vector<HDD*> disks;
+  for (uint32 i=0; i<opt.disks; i++) {
+    HDD *hdd = create_disk(opt.cfg, opt.policy,
+                           (i > 0) || (strcmp(opt.output, "human") != 0));
+    if (hdd == NULL) break;
+    setup_disk(hdd, opt);
+    disks.push_back(hdd);
+  }
+
+  DiskArray *array = NULL;
+  if (disks.size() == opt.disks) {
+    array = DiskArray::create(opt.raid, disks, opt.stripe, opt.jobs);
+  }
+  if (array == NULL) {
+    for (size_t i=0; i<disks.size(); i++) delete disks[i];
+    return EXIT_FAILURE;
+  }
+
+  MergedTraceReader *merged;
+  TraceReader *in = open_trace(opt, &merged);
+  ResultSink *sink = NULL;
+  if (in != NULL) {
+    sink = ResultSink::create(opt.output, opt.output_file, disks[0]->verbose());
+  }
+  if (sink == NULL) {
+    delete in;
+    delete array;
+    return EXIT_FAILURE;
+  }
+  sink->keep_slowest(opt.top);
+  if (merged != NULL) sink->track_tenants(merged->tenants());
+
+  //
+  // the records go to stdout: print the messages and totals on stderr
+  //
+  streambuf *cout_buf = cout.rdbuf();
+  if (sink->to_stdout()) cout.rdbuf(cerr.rdbuf());
+
+  if (sink->human()) {
+    cout << "RAID-" << array->level() << " array of " << array->members()
+         << " disks, stripe unit " << array->stripe() << " blocks, "
+         << array->blocks() << " blocks" << endl << endl;
+    if (opt.trace == NULL) cout << "reading trace from stdin..." << endl << endl;
+  }
+
+  //
+  // process requests in batches
+  //
+  TraceRequest req;
+  ResultRecord res;
+  vector<ArrayRequest> batch;
+  vector<string> comment;
+  vector<uint32> tenant;
+  vector<double> end;
+  double t_tot = 0;
+  uint32 bps = disks[0]->bytes_per_sector(), rop = 0, wop = 0;
+  bool more = true;
+
+  while (more) {
+    batch.clear();
+    comment.clear();
+    tenant.clear();
+    while ((batch.size() < ARRAY_BATCH) && (more = in->next(&req))) {
+      ArrayRequest r = { req.ts, req.rw, req.address / bps,
+                         (req.length + bps-1) / bps };
+      batch.push_back(r);
+      comment.push_back(in->comment());
+      tenant.push_back(merged != NULL ? merged->tenant() : 0);
+      if (req.rw == 'r') rop++;
+      if (req.rw == 'w') wop++;
+    }
+
+    array->access(batch, end);
+
+    for (size_t i=0; i<batch.size(); i++) {
+      res.ts = batch[i].ts;
+      res.rw = batch[i].rw;
+      res.block = batch[i].block;
+      res.nblocks = batch[i].nblocks;
+      res.tenant = tenant[i];
+      res.comment = &comment[i][0];
+      res.queue = res.stall = 0;
+      res.access = DiskAccess();
+      sink->issue(res);
+
+      res.latency = end[i] - batch[i].ts;
+      sink->complete(res);
+      t_tot += res.latency;
+    }
+  }
+
+  for (uint32 i=0; i<opt.disks; i++) disks[i]->flush();
+  if (!sink->flush()) cout << "Error writing output." << endl;
+  if (opt.histogram != NULL) dump_histograms(sink, opt.histogram);
+
+  //
+  // print summary
+  //
+  double busy_min = array->busy(0), busy_max = 0, busy_sum = 0;
+  uint64 hits = 0, misses = 0;
+  for (uint32 i=0; i<array->members(); i++) {
+    busy_min = min(busy_min, array->busy(i));
+    busy_max = max(busy_max, array->busy(i));
+    busy_sum += array->busy(i);
+    const BlockCache *cache = array->member(i)->cache();
+    if (cache != NULL) {
+      hits += cache->hits();
+      misses += cache->misses();
+    }
+  }
+
+  cout.precision(7);
+  cout << endl << dec << fixed
+       << "total time for " << rop+wop << " (read: " << rop << ", write: "
+       << wop << ") operations: " << t_tot << " sec" << endl;
+  print_latency("read", sink->latency('r'));
+  print_latency("write", sink->latency('w'));
+  cout.precision(3);
+  cout << "  array (RAID-" << array->level() << ", " << array->members()
+       << " disks, stripe unit " << array->stripe() << " blocks): "
+       << "saturation throughput: "
+       << (busy_max > 0 ? (rop+wop)/busy_max : 0) << " requests/s" << endl
+       << "    disk busy time: min " << busy_min << " s, mean "
+       << busy_sum/array->members() << " s, max " << busy_max << " s"
+       << endl;
+  if (array->level() == 5) {
+    cout << "    writes: " << array->full_stripe_writes() << " full rows, "
+         << array->rmw_writes() << " rows read-modify-write" << endl;
+  }
+  if (hits + misses > 0) {
+    cout << "  caches: " << hits << " hits, " << misses << " misses, "
+         << "miss rate: " << (double)misses/(hits+misses)*100 << "%" << endl;
+  }
+  print_tenants(sink, merged);
+  print_slowest(sink);
+  cout << endl;
+  cout.rdbuf(cout_buf);
+
+  delete sink;
+  delete array;
+  delete in;
+
+  return EXIT_SUCCESS;
 }
 
 /// @brief program entry point
@@ -193,107 +1300,281 @@ int main(int argc, char *argv[])
   //
   // parse command line and create HDD instance
   //
-  char *config_fn, *trace_fn;
+  Options opt;
+
+  parse_arguments(argc, argv, &opt);
 
-  parse_arguments(argc, argv, &config_fn, &trace_fn);
+  if (opt.sweep) return run_sweep(opt);
+  if (opt.raid >= 0) return run_array(opt);
 
-  HDD *hdd = create_disk(config_fn);
+  HDD *hdd = create_disk(opt.cfg, opt.policy,
+                         strcmp(opt.output, "human") != 0);
   if (hdd == NULL) return EXIT_FAILURE;
+  setup_disk(hdd, opt);
+
+  MergedTraceReader *merged;
+
+  if ((opt.threads > 0) || (opt.mrc > 0)) {
+    TraceReader *in = open_trace(opt, &merged);
+    int res = EXIT_FAILURE;
+    if (in != NULL) {
+      res = opt.threads > 0 ? run_setsim(hdd, in, opt.threads)
+                            : run_mrc(hdd, in, opt);
+    }
+    delete in;
+    delete hdd;
+    return res;
+  }
+
+  //
+  // requests go to the flash tier if there is one (it owns the HDD)
+  //
+  Disk *disk = hdd;
+  TieredDisk *tier = NULL;
+  if (opt.tier != NULL) {
+    disk = tier = create_tier(opt.tier, hdd);
+    if (tier == NULL) {
+      delete hdd;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // open trace and output
+  //
+  TraceReader *in = open_trace(opt, &merged);
+  ResultSink *sink = NULL;
+  if (in != NULL) {
+    sink = ResultSink::create(opt.output, opt.output_file, hdd->verbose());
+  }
+  if (sink == NULL) {
+    delete in;
+    delete disk;
+    return EXIT_FAILURE;
+  }
+  sink->keep_slowest(opt.top);
+  if (merged != NULL) sink->track_tenants(merged->tenants());
+
+  //
+  // the records go to stdout: print the messages and totals on stderr
+  //
+  streambuf *cout_buf = cout.rdbuf();
+  if (sink->to_stdout()) cout.rdbuf(cerr.rdbuf());
+
+  //
+  // continue from a checkpoint
+  //
+  RunState run = { 0, 0, 0, 0, 0 };
+  if ((opt.restore != NULL) &&
+      !restore_checkpoint(opt.restore, &run, opt.trace, in, hdd, sink)) {
+    cout.rdbuf(cout_buf);
+    delete sink;
+    delete in;
+    delete disk;
+    return EXIT_FAILURE;
+  }
 
   //
   // standard tests
   //
-  cout.precision(7);
-  cout << "avg. seek time:    " << dec << fixed
-       << hdd->seek_time(0, hdd->tracks_per_surface()/2) << endl
-       << "seek 1 track:      " << dec << fixed << hdd->seek_time(0, 1) <<endl
-       << "avg. rot. latency: " << dec << fixed << hdd->wait_time() << endl
-       << "read 1 sector:     " << dec << fixed << hdd->read_time(1) << endl
-       << "write 1 sector:    " << dec << fixed << hdd->write_time(1) << endl
-       << "(all units in milliseconds)" << endl
-       << endl;
+  if (sink->human()) {
+    cout.precision(7);
+    cout << "avg. seek time:    " << dec << fixed
+         << hdd->seek_time(0, hdd->tracks_per_surface()/2) << endl
+         << "seek 1 track:      " << dec << fixed << hdd->seek_time(0, 1)
+         << endl
+         << "avg. rot. latency: " << dec << fixed << hdd->wait_time() << endl
+         << "read 1 sector:     " << dec << fixed << hdd->read_time(1) << endl
+         << "write 1 sector:    " << dec << fixed << hdd->write_time(1)
+         << endl
+         << "(all units in milliseconds)" << endl
+         << endl;
+
+    if (opt.trace == NULL) cout << "reading trace from stdin..." << endl << endl;
+  }
 
   //
   // process requests from trace file
   //
-  istream *in = &cin;
-  if (trace_fn != NULL) in = new ifstream(trace_fn);
-  else cout << "reading trace from stdin..." << endl << endl;
+  TraceRequest req;
+  ResultRecord res;
+  double t_out, t_tot = run.t_tot, t_wr = run.t_wr;
+  uint32 bps = hdd->bytes_per_sector(), rop = run.rop, wop = run.wop;
+  uint64 nreq = run.requests;
+  bool checkpoint = opt.checkpoint != NULL, ok = true;
+  DiskQueue *queue = NULL;
 
-  #define CMT_SIZE 2048   ///< max. length of comment
-  char comment[CMT_SIZE], *trimmed, rw;
-  double t_in, t_out, t_tot;
-  bool verbose = hdd->verbose();
-  uint32 bps = hdd->bytes_per_sector(), rop = 0, wop = 0;
-  uint64 address, length, block, nblocks;
+  if (opt.queue > 0) {
+    queue = new DiskQueue(hdd,
+                          DiskScheduler::create(opt.scheduler != NULL
+                                                ? opt.scheduler : "fcfs"),
+                          opt.queue, sink);
+  }
 
-  while (in->good()) {
+  while (in->next(&req)) {
     //
-    // get next line from input trace
+    // save the state before the checkpoint request and stop
     //
-    (*in) >> t_in >> rw >> address >> length;
-    in->getline(comment, CMT_SIZE, '\n');
-    trimmed = trim(comment);
+    if (checkpoint &&
+        ((nreq >= opt.checkpoint_at) || (req.ts >= opt.checkpoint_time))) {
+      RunState now = { nreq, rop, wop, t_tot, t_wr };
+      ok = save_checkpoint(opt.checkpoint, now, opt.trace, hdd, sink);
+      checkpoint = false;
+      break;
+    }
+    nreq++;
 
-    if (!in->good()) break;
+    if (req.rw == 'r') rop++;
+    if (req.rw == 'w') wop++;
+
+    uint32 tenant = merged != NULL ? merged->tenant() : 0;
+    if (queue != NULL) {
+      queue->submit(req, in->comment(), tenant);
+      continue;
+    }
 
     //
     // convert to address to block number, length to #blocks
     //
-    block = address / bps;
-    nblocks = (length + bps-1) / bps;
+    res.ts = req.ts;
+    res.rw = req.rw;
+    res.block = req.address / bps;
+    res.nblocks = (req.length + bps-1) / bps;
+    res.tenant = tenant;
+    res.comment = in->comment();
+    res.queue = res.stall = 0;
+
+    sink->issue(res);
 
     //
-    // print access info
+    // access disk
     //
-    cout.precision(7);
-    if (*trimmed != '\0') cout << trim(comment) << endl;
-    switch (rw) {
-      case 'r': cout << "read "; break;
-      case 'w': cout << "write"; break;
-      default : cout << "error in input trace";
+    t_out = req.ts;
+    switch (req.rw) {
+      case 'r': t_out = disk->read(req.ts, res.block, res.nblocks); break;
+      case 'w': t_out = disk->write(req.ts, res.block, res.nblocks); break;
     }
-    cout << "(" << setw(8) << block << ", " << setw(4) << nblocks << ") = ";
-    cout.flush();
+    t_tot += t_out - req.ts;
+    if (req.rw == 'w') t_wr += t_out - req.ts;
 
-    //
-    // access hdd
-    //
-    switch (rw) {
-      case 'r': rop++; t_out = hdd->read(t_in, block, nblocks); break;
-      case 'w': wop++; t_out = hdd->write(t_in, block, nblocks); break;
+    res.latency = t_out - req.ts;
+    if (tier != NULL) {
+      res.stall = tier->stall();
+      res.access = tier->last_access();
+    } else {
+      res.stall = hdd->stall();
+      res.access = hdd->last_access();
     }
-    t_tot += t_out - t_in;
+    sink->complete(res);
+  }
+  if (in->failed()) ok = false;
 
-    //
-    // print result
-    //
-    cout.precision(7);
-    cout << t_out-t_in << " ms" << endl;
-    if (verbose || (*trimmed != '\0')) cout << endl;
+  if (queue != NULL) {
+    queue->drain();
+    t_tot = queue->service_time() + queue->queue_time();
+    t_wr = queue->write_time();
+  }
+  if (checkpoint) {
+    if (!isinf(opt.checkpoint_time) ||
+        ((opt.checkpoint_at != numeric_limits<uint64>::max()) &&
+         (nreq < opt.checkpoint_at))) {
+      cout << "The trace ended before the checkpoint." << endl;
+    }
+    RunState now = { nreq, rop, wop, t_tot, t_wr };
+    ok = save_checkpoint(opt.checkpoint, now, opt.trace, hdd, sink);
   }
+  double t_flush = tier != NULL ? tier->flush() : hdd->flush();
+
+  if (!sink->flush()) cout << "Error writing output." << endl;
+  if (opt.histogram != NULL) dump_histograms(sink, opt.histogram);
 
   //
   // print summary
   //
-  cout << endl << dec
+  cout.precision(7);
+  cout << endl << dec << fixed
        << "total time for " << rop+wop << " (read: " << rop << ", write: "
        << wop << ") operations: " << t_tot << " sec" << endl;
+  print_latency("read", sink->latency('r'));
+  print_latency("write", sink->latency('w'));
   const BlockCache* cache = hdd->cache();
   if (cache != NULL) {
     cout.precision(3);
-    cout << "  cache (" << cache->size() << " blocks): " << cache->hits()
+    cout << "  cache (" << cache->size() << " blocks, " << cache->policy()
+         << "): " << cache->hits()
          << " hits, " << cache->misses() << " misses, miss rate: "
          << cache->miss_rate()*100 << "%" << endl;
   }
+  if (tier != NULL) {
+    const SSD *ssd = tier->ssd();
+    uint64 n = tier->hits() + tier->misses();
+    cout.precision(3);
+    cout << "  flash tier (" << tier->slots() << " pages of "
+         << ssd->page_blocks() << " blocks, admit " << tier->admission()
+         << ", " << tier->eviction() << "): " << tier->hits() << " hits, "
+         << tier->misses() << " misses, miss rate: "
+         << (n > 0 ? (double)tier->misses()/n*100 : 0) << "%" << endl
+         << "    " << tier->admitted() << " pages admitted, "
+         << tier->evicted() << " evicted, " << tier->destaged()
+         << " destaged; SSD write amplification: "
+         << ssd->write_amplification() << ", " << ssd->erases()
+         << " block erases" << endl;
+  }
+  if (queue != NULL) {
+    uint64 n = queue->served();
+    double span = queue->makespan();
+    cout.precision(3);
+    cout << "  queue (depth " << opt.queue << ", "
+         << (opt.scheduler != NULL ? opt.scheduler : "fcfs") << "): "
+         << "avg. queueing delay: "
+         << (n > 0 ? queue->queue_time()/n*1000 : 0)
+         << " ms, avg. service time: "
+         << (n > 0 ? queue->service_time()/n*1000 : 0) << " ms" << endl
+         << "    throughput: " << (span > 0 ? n/span : 0)
+         << " requests/s, utilization: "
+         << (span > 0 ? queue->service_time()/span*100 : 0) << "%" << endl;
+  }
+  const TrackBuffer *tb = hdd->track_buffer();
+  if (tb != NULL) {
+    uint64 n = tb->hits() + tb->misses();
+    cout.precision(3);
+    cout << "  track buffer (" << tb->segments() << " segments"
+         << (tb->zero_latency() ? ", zero-latency" : "") << "): "
+         << tb->hits() << " hits, " << tb->misses() << " misses, hit rate: "
+         << (n > 0 ? (double)tb->hits()/n*100 : 0) << "%" << endl;
+  }
+  const Prefetcher *pf = hdd->prefetcher();
+  if (pf != NULL) {
+    cout.precision(3);
+    cout << "  readahead: " << pf->issued() << " blocks, " << pf->useful()
+         << " useful, " << pf->evicted() << " evicted unused, accuracy: "
+         << pf->accuracy()*100 << "%, coverage: " << pf->coverage()*100
+         << "%" << endl;
+  }
+  if (hdd->write_back()) {
+    uint64 stalls = hdd->stalls();
+    cout.precision(3);
+    cout << "  write-back: avg. write latency: "
+         << (wop > 0 ? t_wr/wop*1000 : 0) << " ms, "
+         << stalls << " flush stalls (avg. "
+         << (stalls > 0 ? hdd->stall_time()/stalls*1000 : 0) << " ms)" << endl
+         << "    " << hdd->destaged() << " blocks destaged in "
+         << hdd->destage_runs() << " writes, final flush: "
+         << t_flush*1000 << " ms" << endl;
+  }
+  print_tenants(sink, merged);
+  print_slowest(sink);
   cout << endl;
+  cout.rdbuf(cout_buf);
 
   //
   // cleanup & exit
   //
-  delete hdd;
-  if (in != &cin) delete in;
+  delete queue;
+  delete sink;
+  delete disk;
+  delete in;
 
-  return EXIT_SUCCESS;
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
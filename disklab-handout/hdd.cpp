@@ -36,7 +36,10 @@
 #include <limits>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 
@@ -50,8 +53,8 @@ HDD::HDD(uint32 surfaces, uint32 tracks_per_surface,
          uint32 sectors_innermost_track, uint32 sectors_outermost_track,
          uint32 rpm, uint32 sector_size,
          double seek_overhead, double seek_per_track,
-         uint32 cache_blocks,
-         bool verbose)
+         uint32 cache_blocks, const char *cache_policy,
+         bool verbose, bool quiet)
   : _surfaces(surfaces), _tracks_per_surface(tracks_per_surface), _rpm(rpm),
     _sector_size(sector_size), _seek_overhead(seek_overhead),
     _seek_per_track(seek_per_track), _verbose(verbose)
@@ -67,13 +70,54 @@ HDD::HDD(uint32 surfaces, uint32 tracks_per_surface,
   _cache;             ///< disk cache*/
   _head_pos=0; // it is assumed that the head starts being above the track 0
   _surface_pos=0;
+  _track_rot_pos=false;
+  _rot_time=60.0/_rpm;
+  _write_back=false;
+  _dirty_high=_dirty_low=0;
+  _idle_from=_stall=_stall_time=0.0;
+  _stalls=_destaged=_destage_runs=0;
+  _prefetch=NULL;
+  _track_buf=NULL;
+  _access=DiskAccess();
   _sectors_innermost_track=sectors_innermost_track;
   _sectors_outermost_track=sectors_outermost_track;
+  _cache=cache_blocks>=2 ? BlockCache::create(cache_policy, cache_blocks,
+                                              verbose, quiet)
+                         : NULL;
+
+  assert(_tracks_per_surface >= 2);
+
+  //
+  // precompute the cumulative number of sectors per surface so that decode()
+  // can locate a track by binary search instead of summing up all tracks
+  //
+  _track_start.resize((size_t)_tracks_per_surface+1);
+  _track_start[0]=0;
+  for (uint32 t=0; t<_tracks_per_surface; t++) {
+    _track_start[t+1]=_track_start[t]+sectors_track(t);
+  }
+
+  //
+  // prefix sums of the rotations needed to read consecutive full tracks. A
+  // full track t is read while the head is still accounted on track t-1 (see
+  // transfer()), hence the ratio sectors_track(t)/sectors_track(t-1).
+  //
+  _track_rot.resize(_tracks_per_surface);
+  _track_rot[0]=0.0;
+  for (uint32 t=1; t<_tracks_per_surface; t++) {
+    _track_rot[t]=_track_rot[t-1]
+                  +(double)sectors_track(t)/(double)sectors_track(t-1);
+  }
+
+  // the last track is not counted (see sectors_surface())
+  _sectors_surface=_track_start[_tracks_per_surface-1];
+  _capacity=(uint64)_surfaces*_sectors_surface*_sector_size;
 
 
   //
   // print info
   //
+  if (quiet) return;
   cout.precision(3);
   cout << "HDD: " << endl
        << "  surfaces:                  " << _surfaces << endl
@@ -83,13 +127,95 @@ HDD::HDD(uint32 surfaces, uint32 tracks_per_surface,
        << "  rpm:                       " << _rpm << endl
        << "  sector size:               " << _sector_size << endl
        << "  cache blocks:              " << cache_blocks << endl
+       << "  cache policy:              " << cache_policy << endl
        << endl;
        if (verbose) cout<<"capacity "<<dec<<(double)capacity()/pow(2.0,20.0)<< endl;
 }
 
 HDD::~HDD(void)
 {
-  // TODO
+  delete _prefetch;
+  delete _track_buf;
+  delete _cache;
+}
+
+bool HDD::read_config(const char *cfg, const char *policy, HDD_Config *c)
+{
+  //
+  // open HDD configuration file
+  //
+  ifstream in(cfg);
+  if (!in.good()) {
+    cout << "Cannot open configuration file '" << cfg << "'." << endl;
+    return false;
+  }
+
+  //
+  // read HDD parameters
+  //
+  in >> c->surfaces;
+  in >> c->tracks_per_surface;
+  in >> c->sectors_innermost;
+  in >> c->sectors_outermost;
+  in >> c->rpm;
+  in >> c->bytes_per_sector;
+  in >> c->seek_overhead;
+  in >> c->seek_per_track;
+  in >> c->cache_size;
+  in >> c->verbose;
+
+  if (!in.good()) {
+    cout << "Error reading HDD parameters from configuration file." << endl;
+    return false;
+  }
+
+  //
+  // optional cache replacement policy, write policy and dirty high watermark
+  //
+  string cfg_policy, write_policy = "wt";
+  c->cache_policy = "lru";
+  c->high_watermark = 0.5;
+  if (in >> cfg_policy) c->cache_policy = cfg_policy;
+  if (policy != NULL) c->cache_policy = policy;
+  if (in >> write_policy) in >> c->high_watermark;
+  c->write_back = write_policy == "wb";
+
+  if (!BlockCache::is_policy(c->cache_policy.c_str())) {
+    cout << "Unknown cache replacement policy '" << c->cache_policy << "'."
+         << endl;
+    return false;
+  }
+
+  if ((write_policy != "wt") && (write_policy != "wb")) {
+    cout << "Unknown write policy '" << write_policy << "'." << endl;
+    return false;
+  }
+
+  if ((c->high_watermark <= 0) || (c->high_watermark > 1)) {
+    cout << "Invalid dirty high watermark " << c->high_watermark << "."
+         << endl;
+    return false;
+  }
+
+  if (c->write_back && (c->cache_size < 2)) {
+    cout << "Write-back caching requires a disk cache." << endl;
+    return false;
+  }
+
+  return true;
+}
+
+HDD* HDD::create(const HDD_Config &c, bool quiet)
+{
+  HDD *hdd = new HDD(c.surfaces, c.tracks_per_surface,
+                     c.sectors_innermost, c.sectors_outermost,
+                     c.rpm, c.bytes_per_sector,
+                     c.seek_overhead, c.seek_per_track,
+                     c.cache_size, c.cache_policy.c_str(),
+                     c.verbose && !quiet, quiet);
+  hdd->write_back(c.write_back, c.high_watermark);
+
+  return hdd;
 }
 
 uint32 HDD::bytes_per_sector(void) const
@@ -111,7 +237,14 @@ uint32 HDD::tracks_per_surface(void) const
     num_track is the numero of the track the innermost_track having numero 0 ...*/
 uint64 HDD::sectors_track(uint32 num_track) const
 {
-  return (_sectors_innermost_track) + num_track * (_sectors_outermost_track - _sectors_innermost_track)/(_tracks_per_surface-1);
+  return (uint64)_sectors_innermost_track
+    + (uint64)num_track*(_sectors_outermost_track - _sectors_innermost_track)
+      /(_tracks_per_surface-1);
+}
+
+int64 HDD::sector_base(uint32 track) const
+{
+  return (int64)_track_start[track+1]-(int64)sectors_track(track+1);
 }
 
 /**********************************************************************************/
@@ -120,13 +253,7 @@ uint64 HDD::sectors_track(uint32 num_track) const
     ///Sectors_surface: return the number of sectors per surface
 uint64 HDD::sectors_surface(void) const
 {
-  int i=0,sum=0;
-
-  for(i=0;i<(_tracks_per_surface-1);i++){
-    sum+=sectors_track(i);
-  }
-
-  return sum;
+  return _sectors_surface;
 }
 
 /**********************************************************************************/
@@ -134,7 +261,7 @@ uint64 HDD::sectors_surface(void) const
  */
 uint64 HDD::capacity(void) const
 {
-  return _surfaces * sectors_surface()*_sector_size;
+  return _capacity;
 }
 
 /**********************************************************************************/
@@ -155,6 +282,230 @@ bool HDD::verbose(void) const
   return _verbose;
 }
 
+uint32 HDD::head_track(void) const
+{
+  return _head_pos;
+}
+
+uint32 HDD::track_of(uint64 block) const
+{
+  // same search as in decode(), without the checks and output
+  uint64 psector=block/_surfaces;
+  uint32 track=(uint32)(upper_bound(_track_start.begin()+1,
+                                    _track_start.end(), psector)
+                        - _track_start.begin()) - 1;
+  return track<_tracks_per_surface ? track : _tracks_per_surface-1;
+}
+
+double HDD::angle_of(uint64 block) const
+{
+  // sector index as computed by decode(), without the checks and output
+  uint32 track=track_of(block);
+  int64 sector=(int64)(block/_surfaces)-sector_base(track);
+  uint64 nsectors=sectors_track(track);
+  if(sector<0) sector=0;
+  if((uint64)sector>=nsectors) sector=nsectors-1;
+
+  return (double)sector/(double)nsectors;
+}
+
+double HDD::rotation_time(void) const
+{
+  return _rot_time;
+}
+
+bool HDD::tracks_rotation(void) const
+{
+  return _track_rot_pos;
+}
+
+const DiskAccess& HDD::last_access(void) const
+{
+  return _access;
+}
+
+void HDD::track_rotation(bool on)
+{
+  _track_rot_pos=on;
+}
+
+/**********************************************************************************/
+/*
+ */
+double HDD::platter_angle(double ts) const
+{
+  double a=fmod(ts/_rot_time, 1.0);
+  return a<0.0 ? a+1.0 : a;
+}
+
+double HDD::seek_cost(uint32 from_track, uint32 to_track) const
+{
+  if(from_track==to_track) return 0.0;
+  uint32 d=from_track>to_track ? from_track-to_track : to_track-from_track;
+  return _seek_overhead+(double)d*_seek_per_track;
+}
+
+double HDD::positioning_time(double ts, uint32 track, double angle) const
+{
+  double seek=seek_cost(_head_pos, track);
+  if(!_track_rot_pos) return seek+((60.0)/_rpm)/2.0;
+
+  //the sector passes under the heads when the platters have turned from
+  //their angle at the end of the seek to the sector's angle
+  double wait=angle-platter_angle(ts+seek);
+  if(wait<0.0) wait+=1.0;
+  return seek+wait*_rot_time;
+}
+
+
+/**********************************************************************************/
+/*
+ */
+void HDD::write_back(bool on, double high_watermark)
+{
+  _write_back=on && (_cache!=NULL);
+  if(!_write_back) return;
+
+  _dirty_high=(uint64)(high_watermark*_cache->size());
+  if(_dirty_high<1) _dirty_high=1;
+  _dirty_low=_dirty_high/2;
+}
+
+bool HDD::write_back(void) const
+{
+  return _write_back;
+}
+
+double HDD::flush(void)
+{
+  double t=_idle_from;
+  if(!_write_back) return 0.0;
+
+  while(_cache->dirty()>0) t=destage(t);
+  t-=_idle_from;
+  _idle_from+=t;
+  return t;
+}
+
+double HDD::stall(void) const
+{
+  return _stall;
+}
+
+uint64 HDD::stalls(void) const
+{
+  return _stalls;
+}
+
+double HDD::stall_time(void) const
+{
+  return _stall_time;
+}
+
+uint64 HDD::destaged(void) const
+{
+  return _destaged;
+}
+
+uint64 HDD::destage_runs(void) const
+{
+  return _destage_runs;
+}
+
+void HDD::readahead(bool on)
+{
+  delete _prefetch;
+  _prefetch=NULL;
+  if(on && (_cache!=NULL))
+  {
+    _prefetch=new Prefetcher(_cache, (uint64)_surfaces*_sectors_surface);
+  }
+}
+
+const Prefetcher* HDD::prefetcher(void) const
+{
+  return _prefetch;
+}
+
+void HDD::track_buffer(uint32 segments, bool zero_latency)
+{
+  delete _track_buf;
+  _track_buf=segments>0 ? new TrackBuffer(segments, zero_latency) : NULL;
+}
+
+const TrackBuffer* HDD::track_buffer(void) const
+{
+  return _track_buf;
+}
+
+void HDD::save(CheckpointWriter &out) const
+{
+  uint32 geometry[6]={ _surfaces, _tracks_per_surface, _sectors_innermost_track,
+                       _sectors_outermost_track, _rpm, _sector_size };
+  bool has[3]={ _cache!=NULL, _prefetch!=NULL, _track_buf!=NULL };
+
+  out.section("HDD ");
+  out.put(geometry);
+  out.put_bool(_write_back);
+  out.put_bool(_track_rot_pos);
+  for (int i=0; i<3; i++) out.put_bool(has[i]);
+  out.put(_head_pos);
+  out.put(_surface_pos);
+  out.put(_idle_from);
+  out.put(_stall);
+  out.put(_stalls);
+  out.put(_stall_time);
+  out.put(_destaged);
+  out.put(_destage_runs);
+  save_access(out, _access);
+
+  if(_cache!=NULL) _cache->save(out);
+  if(_prefetch!=NULL) _prefetch->save(out);
+  if(_track_buf!=NULL) _track_buf->save(out);
+}
+
+bool HDD::restore(CheckpointReader &in)
+{
+  uint32 geometry[6]={ _surfaces, _tracks_per_surface, _sectors_innermost_track,
+                       _sectors_outermost_track, _rpm, _sector_size };
+  uint32 saved[6];
+  bool write_back, track_rot_pos, has[3];
+
+  if(!in.section("HDD ") || !in.get(saved) || !in.get_bool(write_back) ||
+     !in.get_bool(track_rot_pos) || !in.get_bool(has[0]) ||
+     !in.get_bool(has[1]) || !in.get_bool(has[2])) return false;
+  if(memcmp(saved, geometry, sizeof(saved))!=0) {
+    return in.fail("the disk geometry differs");
+  }
+  if((write_back!=_write_back) || (track_rot_pos!=_track_rot_pos)) {
+    return in.fail("the write policy or rotational position tracking differs");
+  }
+  if(has[0]!=(_cache!=NULL)) return in.fail("the disk cache differs");
+
+  if(!in.get(_head_pos) || !in.get(_surface_pos) || !in.get(_idle_from) ||
+     !in.get(_stall) || !in.get(_stalls) || !in.get(_stall_time) ||
+     !in.get(_destaged) || !in.get(_destage_runs) ||
+     !restore_access(in, _access)) {
+    return false;
+  }
+  if(_head_pos>=_tracks_per_surface || _surface_pos>=_surfaces) {
+    return in.fail("corrupt head position");
+  }
+
+  if((_cache!=NULL) && !_cache->restore(in)) return false;
+  if(has[1]) {
+    if(_prefetch!=NULL ? !_prefetch->restore(in) : !in.skip("PREF")) {
+      return false;
+    }
+  }
+  if(has[2]) {
+    if(_track_buf!=NULL ? !_track_buf->restore(in) : !in.skip("TBUF")) {
+      return false;
+    }
+  }
+
+  return true;
+}
 
 /**********************************************************************************/
 /*
@@ -230,52 +581,35 @@ bool HDD::decode(uint64 block, HDD_Position *pos) const
     return false;
   } 
   //block negative or greater than the number of blocks in the disk drive
-  if(block<0 || block >=(sectors_surface()*_surfaces) )
+  if(block >= _sectors_surface*_surfaces)
   {
      cout<<" block is too big or negative"<<dec<<block<<endl; 
     return false;
   }
 
-
-
-
   //surface 
   pos->surface=block%_surfaces; 
  
   //to the find the track containing this block
-  // It is equivalent to find the track for which the block is smaller or equal than the maximum block number of this track
-  int i=1, sum=sectors_track(0);
-
-  while(block>((sum*_surfaces)-1) && i<_tracks_per_surface)
-  {
-
-    sum+= sectors_track(i);
-    i++;
-  }
-
-  if(i>=_tracks_per_surface) // useless since checking has already been done /////////////////////////////////////////////////////
-  {
-    cout<<"debug: block is too big"<<dec<<block<<endl; 
-    return false;
-  }
-  pos->track=i-1;
+  // It is the first track whose last block is greater or equal than the block,
+  // i.e., the first track t with block/_surfaces < _track_start[t+1]
+  uint64 psector=block/_surfaces;
+  pos->track=(uint32)(upper_bound(_track_start.begin()+1, _track_start.end(),
+                                  psector) - _track_start.begin()) - 1;
 
   //block
-  //find the block on the track with the same number 
-  int cursor=(sum-sectors_track(i))*_surfaces+pos->surface; //this is the first sector of the track where the sector is.
-  i=0;
-  cout<<"debug: cursor is"<<dec<<cursor<<endl;
-  while(block!=cursor && i< sectors_track(pos->track))
-  {
-    cursor+=_surfaces;
-    i++;
-  }
-  if(i>=sectors_track(pos->track)) // useless since checking has already been done /////////////////////////////////////////////////////
+  //find the block on the track with the same number. The sector index is
+  //counted from sector_base() (as the original linear scan did) so decode()
+  //stays compatible; the base is signed as it can lie before sector 0.
+  uint64 nsectors=sectors_track(pos->track);
+  int64 base=sector_base(pos->track);
+  if(_verbose) cout<<"debug: cursor is"<<dec<<base*(int64)_surfaces+pos->surface<<endl;
+  if((int64)psector<base || (uint64)((int64)psector-base)>=nsectors)
   {
     cout<<"debug: pb with track found, nb block is"<<dec<<block<<endl; 
     return false;
   }
-  pos->sector=i;
+  pos->sector=(uint64)((int64)psector-base);
 
   //max sectors is the number of sectors between the sectors given in parameter and the end of the track
   // it is the number of sectors in the track minus the position of the given sector( which is count), and then multiply by the number of surfaces ;
@@ -283,11 +617,14 @@ bool HDD::decode(uint64 block, HDD_Position *pos) const
   pos->max_sectors=((sectors_track(pos->track)-pos->sector)*_surfaces)-pos->surface;
 
 
-  //printing
-  cout<< "HDD::decode("<<dec<<block<<")= surface "<<dec<<pos->surface
-  <<"/ track "<<dec<<pos->track
-  <<"/ sector "<<dec<<pos->sector
-  <<"/ max_sectors "<<dec<<pos->max_sectors<<endl;
+  //printing (verbose only, decode() is on the path of every request)
+  if(_verbose)
+  {
+    cout<< "HDD::decode("<<dec<<block<<")= surface "<<dec<<pos->surface
+    <<"/ track "<<dec<<pos->track
+    <<"/ sector "<<dec<<pos->sector
+    <<"/ max_sectors "<<dec<<pos->max_sectors<<endl;
+  }
   return true;
 }
 
@@ -296,66 +633,267 @@ bool HDD::decode(uint64 block, HDD_Position *pos) const
  */
 /*-get the position using decode(block)
   -modify head_pos to the position track;
-  - return the timestamp + all the result of the previous functions returning a time ( except write_time)   call read_time with sectors, seek_time with head_pos and the position track 
+  - return the timestamp + all the result of the previous functions returning a time
+  read() and write() share the same path, see transfer()
  */
 
 double HDD::read(double ts, uint64 block, uint64 nblocks)
 {
-  HDD_Position pos;
-  uint64 read_track, sum=0;
-  double seek_tim=0, read_tim=0, nb_track=0;
+  return transfer(ts, block, nblocks, false);
+}
 
-  if(!decode(block, &pos)) return -1.1; // a print is done is decode in case of return value is false
-  /*init surface position */
-  _surface_pos=pos.surface;
 
-  seek_tim=seek_time(_head_pos, pos.track);
-  if(nblocks-sum<pos.max_sectors) read_tim=read_time(nblocks); 
-  else
-  { 
-    read_tim=read_time(pos.max_sectors);
-  }
-  //since we don't know the number of track that are going to be read, a loop is necessary
-  while(nblocks-sum>pos.max_sectors)
-  {
-    //udpates 
-    _head_pos=pos.track+nb_track;
-    pos.track++;
-    pos.sector=0;
-     sum+=pos.max_sectors;
-    pos.max_sectors= sectors_track(pos.track)*_surfaces;
-   
-    cout<<"whoooooooooo max sec"<<dec<<pos.max_sectors<<"et sum"<<dec<<sum<<"et nblock -sum" << dec<<nblocks-sum<<endl;
+/**********************************************************************************/
+/*
+ */
+
+double HDD::write(double ts, uint64 block, uint64 nblocks)
+{
+  return transfer(ts, block, nblocks, true);
+}
 
 
-    if(nblocks-sum>pos.max_sectors) read_track=pos.max_sectors;// we read all we can in this track
-    else {read_track=nblocks-sum;} // we read what we need on this track and the loop stop after this iteration
+/**********************************************************************************/
+/*
+ */
+/* the cache decides whether a request goes to the disk (see media_access())
+ */
+double HDD::transfer(double ts, uint64 block, uint64 nblocks, bool write)
+{
+  _stall=0.0;
+  _access=DiskAccess();
 
-    seek_tim+=seek_time(_head_pos, pos.track);
-    read_tim+=read_time(read_track);
+  //
+  // write-through: reads are served from the disk cache if all blocks are
+  // cached; written blocks are put into the cache and written to the disk
+  //
+  if(!_write_back)
+  {
+    if(_cache!=NULL)
+    {
+      if(!write) return cached_read(ts, block, nblocks);
+      _cache->put_range(block, nblocks);
+    }
+    return media_access(ts, block, nblocks, write);
+  }
 
-    
+  //
+  // write-back: destage dirty blocks while the disk is idle before ts. A
+  // destage that has started before ts runs to completion and delays the
+  // request.
+  //
+  double start=ts, end;
+  if(_idle_from<ts)
+  {
+    double t=_idle_from;
+    while((_cache->dirty()>0) && (t<ts)) t=destage(t);
+    if(t>ts) start=t;
+  }
 
-    if(pos.track > _tracks_per_surface)
+  //
+  // writes complete in the cache unless the dirty blocks exceed the high
+  // watermark; reads go to the disk if a block is missing
+  //
+  end=start;
+  if(write)
+  {
+    _cache->put_range(block, nblocks);
+    _cache->mark_dirty(block, nblocks);
+    _access.source=ACCESS_CACHE;
+    if(_cache->dirty()>_dirty_high)
     {
-      cout<<"DEBUG: HDD::read : you want to read too much"<<endl;
-      return -1.2;
+      while(_cache->dirty()>_dirty_low) end=destage(end);
     }
+    _stall=end-ts;
+  }
+  else
+  {
+    _stall=start-ts;
+    end=cached_read(start, block, nblocks);
+    if(end<0) return end;
+  }
 
+  if(_stall>0.0)
+  {
+    _stalls++;
+    _stall_time+=_stall;
   }
- /* cout<<"DEBUG: read_time"<<dec<<read_tim<<endl;*/
+  if(end>_idle_from) _idle_from=end;
 
-  return ts+seek_tim+read_tim+wait_time();
+  return end;
 }
 
-
 /**********************************************************************************/
 /*
  */
+/* a read that misses in the cache goes to the disk. If the prefetcher detects
+   a sequential stream, the blocks read ahead are transferred in the same
+   access and put into the cache.
+ */
+double HDD::cached_read(double ts, uint64 block, uint64 nblocks)
+{
+  uint64 ra=_prefetch!=NULL ? _prefetch->access(block, nblocks) : 0;
 
-double HDD::write(double ts, uint64 block, uint64 nblocks)
+  if(_cache->get_range(block, nblocks)==0)
+  {
+    _access.source=ACCESS_CACHE;
+    return ts;
+  }
+  if(ra==0) return media_access(ts, block, nblocks, false);
+
+  double end=media_access(ts, block, nblocks+ra, false);
+  if(end>=0)
+  {
+    _cache->put_range(block+nblocks, ra);
+    _prefetch->prefetched(block+nblocks, ra);
+  }
+  return end;
+}
+
+/**********************************************************************************/
+/*
+ */
+/* write the dirty run starting at the first dirty block at or after the
+   track under the heads (C-LOOK order). A run ends at the end of its track.
+ */
+double HDD::destage(double ts)
 {
-  // TODO
-  return ts;
+  uint64 block;
+  if(!_cache->next_dirty(_track_start[_head_pos]*_surfaces, &block)) return ts;
+
+  uint32 track=track_of(block);
+  uint64 track_end=_track_start[track+1]*_surfaces;
+  uint64 n=_cache->clean(block, track_end>block ? track_end-block : 1);
+
+  _destaged+=n;
+  _destage_runs++;
+
+  // blocks that cannot be written are dropped. The destage is not part of
+  // the breakdown of the access it delays.
+  DiskAccess access=_access;
+  double t=media_access(ts, block, n, true);
+  _access=access;
+  return t>ts ? t : ts;
 }
 
+/**********************************************************************************/
+/*
+ */
+/* A request is split into
+   - a first part up to the end of the starting track (or the whole request),
+   - n-1 full tracks,
+   - a last part on track pos.track+n.
+  Every track crossed costs a one-track seek. The full tracks are summed in
+  O(1) with _track_rot, and the first/last part go through read_time() or
+  write_time() so that _head_pos and _surface_pos are updated the same way as
+  when the tracks were walked one by one.
+ */
+double HDD::media_access(double ts, uint64 block, uint64 nblocks, bool write)
+{
+  HDD_Position pos;
+  double seek_tim=0, xfer_tim=0, rot_tim=0;
+  uint32 from=_head_pos;
+
+  if(!decode(block, &pos)) return -1.1; // a print is done is decode in case of return value is false
+
+  //sectors [pos.sector, sect_end) of the first track hold the request
+  bool one_track=nblocks<=pos.max_sectors;
+  uint64 nsect=sectors_track(pos.track);
+  uint64 sect_end=one_track
+                  ? pos.sector+(pos.surface+nblocks+_surfaces-1)/_surfaces
+                  : nsect;
+
+  //reads that are in the track buffer do not need the mechanics; writes
+  //make the buffered track stale
+  if(_track_buf!=NULL)
+  {
+    if(write) _track_buf->invalidate(pos.track);
+    else if(one_track && _track_buf->lookup(pos.track, pos.sector, sect_end))
+    {
+      _access.source=ACCESS_BUFFER;
+      return ts;
+    }
+  }
+
+  /*init surface position */
+  _surface_pos=pos.surface;
+
+  //with rotational tracking, the heads move to the track of the request and
+  //wait for its first sector to come around. The average-latency model keeps
+  //seek_time() and the head position as they were for compatibility.
+  if(_track_rot_pos)
+  {
+    rot_tim=positioning_time(ts, pos.track,
+                             (double)pos.sector/sectors_track(pos.track));
+    seek_tim=seek_cost(_head_pos, pos.track);
+    rot_tim-=seek_tim;
+    _head_pos=pos.track;
+  }
+  else
+  {
+    seek_tim=seek_time(_head_pos, pos.track);
+    rot_tim=wait_time();
+  }
+  uint64 first=nblocks<pos.max_sectors ? nblocks : pos.max_sectors;
+  xfer_tim=write ? write_time(first) : read_time(first);
+
+  //the track buffer keeps the rest of the track, read after the request. A
+  //zero-latency read starts as soon as the heads arrive: if they land inside
+  //the request, it takes one rotation instead of waiting for its start.
+  if((_track_buf!=NULL) && !write && one_track)
+  {
+    if(_track_buf->zero_latency())
+    {
+      double arrive=platter_angle(ts+seek_tim)*nsect;
+      if(_track_rot_pos && (arrive>pos.sector) && (arrive<sect_end))
+      {
+        rot_tim=_rot_time-xfer_tim;
+      }
+      _track_buf->fill(pos.track, 0, nsect);
+    }
+    else
+    {
+      _track_buf->fill(pos.track, pos.sector, nsect);
+    }
+  }
+
+  if(nblocks>first)
+  {
+    //find the last track: the first track such that the full tracks
+    //pos.track+1..last hold the remaining blocks
+    uint64 rest=nblocks-first;
+    uint64 base=_track_start[pos.track+1];
+    uint64 need=base+(rest+_surfaces-1)/_surfaces;
+    if(need>_track_start[_tracks_per_surface])
+    {
+      cout<<"DEBUG: HDD::read : you want to read too much"<<endl;
+      return -1.2;
+    }
+    uint32 last=(uint32)(lower_bound(_track_start.begin()+pos.track+1,
+                                     _track_start.end(), need)
+                         - _track_start.begin()) - 1;
+    uint64 ntracks=last-pos.track;
+    _access.tracks+=ntracks;
+
+    //one-track seek for every track crossed
+    seek_tim+=ntracks*seek_time(pos.track, pos.track+1);
+
+    //full tracks pos.track+1..last-1
+    xfer_tim+=(_track_rot[last-1]-_track_rot[pos.track])*60.0/(double)_rpm;
+
+    //remaining sectors on the last track. The average-latency model times
+    //them at the density of track last-1 for compatibility; with rotational
+    //tracking the heads are on track last and read_time() uses its density.
+    _head_pos=_track_rot_pos ? last : last-1;
+    _surface_pos=0;
+    rest-=(_track_start[last]-base)*_surfaces;
+    xfer_tim+=write ? write_time(rest) : read_time(rest);
+  }
+
+  _access.seek+=seek_tim;
+  _access.rotation+=rot_tim;
+  _access.transfer+=xfer_tim;
+  _access.tracks+=from>pos.track ? from-pos.track : pos.track-from;
+
+  return ts+seek_tim+xfer_tim+rot_tim;
+}
@@ -35,8 +35,13 @@
 #ifndef __CA_HDD_H__
 #define __CA_HDD_H__
 
+#include <string>
+#include <vector>
+
 #include "disk.h"
 #include "cache.h"
+#include "prefetch.h"
+#include "trackbuf.h"
 using namespace std;
 
 ///@brief struct encoding a byte position on the disk as a surface/track/sector
@@ -49,18 +54,22 @@ typedef struct HDD_Position {
                                     ///< cutively until the end of this track
 } HDD_Position;
 
-///      struct encoding the element of the cache and the cache itself
-///       this a double linked list.
-typedef struct HDD_Cache_Ele {
-    uint64 cached_block;
-    HDD_Cache_Ele* prev;
-    HDD_Cache_Ele* next;
-}HDD_Cache_Ele;
-
-typedef struct {
-    HDD_Cache_Ele* head;
-    HDD_Cache_Ele* tail;
-}
+///@brief HDD parameters of a configuration file (see HDD::read_config())
+typedef struct HDD_Config {
+  uint32 surfaces;                  ///< number of surfaces
+  uint32 tracks_per_surface;        ///< number of tracks per surface
+  uint32 sectors_innermost;         ///< sectors on the innermost track
+  uint32 sectors_outermost;         ///< sectors on the outermost track
+  uint32 rpm;                       ///< rotations per minute
+  uint32 bytes_per_sector;          ///< size of one sector, in bytes
+  double seek_overhead;             ///< base overhead of a seek, in seconds
+  double seek_per_track;            ///< seek overhead per track, in seconds
+  uint32 cache_size;                ///< number of cache blocks
+  bool   verbose;                   ///< verbose output
+  string cache_policy;              ///< cache replacement policy
+  bool   write_back;                ///< write-back (true) or write-through
+  double high_watermark;            ///< dirty high watermark (write-back)
+} HDD_Config;
 
 //------------------------------------------------------------------------------
 /// @brief rotating disk-based storage devices (HDD)
@@ -82,17 +91,39 @@ class HDD : public Disk {
     /// @param seek_overhead base overhead of seek operation, in seconds
     /// @param seek_per_track linear seek overhead per track, in seconds
     /// @param cache_blocks number of cache blocks in integraded cache
+    /// @param cache_policy replacement policy of the cache (see BlockCache)
     /// @param verbose verbose output
+    /// @param quiet do not print the disk parameters
     HDD(uint32 surfaces, uint32 tracks_per_surface,
         uint32 sectors_innermost_track, uint32 sectors_outermost_track,
         uint32 rpm, uint32 sector_size,
         double seek_overhead, double seek_per_track,
-        uint32 cache_blocks,
-        bool verbose=false);
+        uint32 cache_blocks, const char *cache_policy="lru",
+        bool verbose=false, bool quiet=false);
 
     /// @brief destructor
     virtual ~HDD(void);
 
+    /// @brief read the disk parameters from configuration file @a cfg:
+    ///        the ten constructor parameters up to the verbose flag,
+    ///        optionally followed by the cache replacement policy, the write
+    ///        policy (wt: write-through, wb: write-back) and the dirty high
+    ///        watermark of the write-back cache. Errors are reported on cout.
+    /// @param cfg path to configuration file
+    /// @param policy cache replacement policy overriding the configuration
+    ///        file (NULL: use the configuration file or LRU)
+    /// @param c (output) parameters
+    /// @retval true on success
+    static bool read_config(const char *cfg, const char *policy,
+                            HDD_Config *c);
+
+    /// @brief create a disk with the parameters @a c
+    /// @param c parameters (see read_config())
+    /// @param quiet do not print the disk parameters and ignore the verbose
+    ///        flag
+    /// @retval HDD instance
+    static HDD* create(const HDD_Config &c, bool quiet=false);
+
     /// @}
     //
 
@@ -115,6 +146,147 @@ class HDD : public Disk {
     /// @brief return the verbose flag
     bool verbose(void) const;
 
+    /// @brief return the track the heads are positioned on
+    uint32 head_track(void) const;
+
+    /// @brief return the track holding block @a block
+    uint32 track_of(uint64 block) const;
+
+    /// @brief return the angular position of block @a block as a fraction of
+    ///        a rotation in [0,1), relative to the first sector of its track
+    double angle_of(uint64 block) const;
+
+    /// @brief return the time for one full rotation of the platters
+    double rotation_time(void) const;
+
+    /// @brief return whether the rotational position is tracked
+    bool tracks_rotation(void) const;
+
+    /// @brief return the latency breakdown of the most recent read() or
+    ///        write(). Destaging in write-back mode is not included (see
+    ///        stall()).
+    const DiskAccess& last_access(void) const;
+
+    /// @}
+
+
+    /// @name rotational position
+    /// @{
+
+    /// @brief track the angular position of the platters. With tracking
+    ///        enabled, the rotational latency of an access is the exact time
+    ///        until the first sector passes under the heads instead of the
+    ///        average wait_time(), and seeks are charged by distance in both
+    ///        directions. The platters are at angle 0 at time 0 and turn at
+    ///        a constant rate, so the angle is a function of time only.
+    void track_rotation(bool on);
+
+    /// @brief angular position of the platters at time @a ts, as a fraction
+    ///        of a rotation in [0,1)
+    double platter_angle(double ts) const;
+
+    /// @brief seek time from @a from_track to @a to_track, symmetric in the
+    ///        seek direction
+    double seek_cost(uint32 from_track, uint32 to_track) const;
+
+    /// @brief time from @a ts until the heads are positioned over a sector at
+    ///        angle @a angle on track @a track (seek + rotational latency)
+    double positioning_time(double ts, uint32 track, double angle) const;
+
+    /// @}
+
+
+    /// @name write-back caching
+    /// @{
+
+    /// @brief select write-back (true) or write-through (false) caching.
+    ///        In write-back mode, written blocks are only marked dirty in the
+    ///        cache and complete immediately. Dirty blocks are destaged in
+    ///        track-contiguous runs, in C-LOOK order from the heads, while the
+    ///        disk is idle between requests. When the dirty blocks exceed
+    ///        @a high_watermark of the cache, the write stalls until they
+    ///        have been destaged to half the watermark. A request arriving
+    ///        while a destage is in progress waits for it to finish.
+    ///        Requires a cache.
+    /// @param on enable write-back caching
+    /// @param high_watermark fraction of the cache that may be dirty (0..1]
+    void write_back(bool on, double high_watermark=0.5);
+
+    /// @brief return whether write-back caching is enabled
+    bool write_back(void) const;
+
+    /// @brief destage all dirty blocks once the last access has finished
+    /// @retval time needed to destage the blocks
+    double flush(void);
+
+    /// @brief flush stall of the most recent access, i.e., the part of its
+    ///        latency spent waiting for dirty blocks to be destaged
+    double stall(void) const;
+
+    /// @brief number of accesses that stalled for destaging
+    uint64 stalls(void) const;
+
+    /// @brief total flush stall time
+    double stall_time(void) const;
+
+    /// @brief number of blocks destaged
+    uint64 destaged(void) const;
+
+    /// @brief number of destage writes (runs)
+    uint64 destage_runs(void) const;
+
+    /// @}
+
+
+    /// @name readahead
+    /// @{
+
+    /// @brief enable sequential readahead into the cache (see Prefetcher).
+    ///        Read-ahead blocks are transferred in the same disk access as
+    ///        the read that misses, and are charged to it. Requires a cache.
+    void readahead(bool on);
+
+    /// @brief return the prefetcher or NULL if readahead is disabled
+    const Prefetcher* prefetcher(void) const;
+
+    /// @}
+
+
+    /// @name track buffer
+    /// @{
+
+    /// @brief add a segmented track buffer below the cache (see TrackBuffer).
+    ///        A read of sectors in the buffer completes without seek,
+    ///        rotation and transfer; a read from the platters buffers the
+    ///        rest of its track (the whole track with @a zero_latency). Only
+    ///        reads within one track use the buffer. Zero-latency timing
+    ///        needs the rotational position (track_rotation()).
+    /// @param segments number of segments (0: no track buffer)
+    /// @param zero_latency read-on-arrival
+    void track_buffer(uint32 segments, bool zero_latency=false);
+
+    /// @brief return the track buffer or NULL
+    const TrackBuffer* track_buffer(void) const;
+
+    /// @}
+
+
+    /// @name checkpoints
+    /// @{
+
+    /// @brief write the head position, counters, cache, prefetcher and track
+    ///        buffer to checkpoint @a out (section "HDD " followed by the
+    ///        sections of the components)
+    void save(CheckpointWriter &out) const;
+
+    /// @brief read the state saved by save() from checkpoint @a in. The
+    ///        geometry, write policy and cache must be those of the saved
+    ///        disk. The state of a saved prefetcher or track buffer is
+    ///        skipped if it is disabled now; one enabled now but not saved
+    ///        starts empty.
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
     /// @}
 
 
@@ -170,8 +342,30 @@ class HDD : public Disk {
     uint32 _sectors_innermost_track;
     uint32 _sectors_outermost_track;
     uint32 _surface_pos;
-
-    
+    bool   _track_rot_pos;          ///< track the rotational position
+    double _rot_time;               ///< time for one rotation
+
+    bool   _write_back;             ///< write-back caching
+    uint64 _dirty_high;             ///< dirty blocks that force a flush
+    uint64 _dirty_low;              ///< dirty blocks after a forced flush
+    double _idle_from;              ///< time the disk finished its last access
+    double _stall;                  ///< flush stall of the last access
+    uint64 _stalls;                 ///< number of stalled accesses
+    double _stall_time;             ///< total flush stall time
+    uint64 _destaged;               ///< number of blocks destaged
+    uint64 _destage_runs;           ///< number of destage writes
+    Prefetcher *_prefetch;          ///< readahead (NULL: off)
+    TrackBuffer *_track_buf;        ///< track buffer (NULL: off)
+    DiskAccess _access;             ///< breakdown of the last access
+
+    uint64 _sectors_surface;        ///< cached sectors_surface()
+    uint64 _capacity;               ///< cached capacity() in bytes
+    vector<uint64> _track_start;    ///< _track_start[t]: sectors/surface on
+                                    ///< tracks 0..t-1 (prefix table, size
+                                    ///< tracks_per_surface+1)
+    vector<double> _track_rot;      ///< _track_rot[t]: sum of full-track
+                                    ///< rotations sectors_track(k)/sectors_
+                                    ///< track(k-1) for tracks k=1..t
 
     /// @brief translate a block index into a position on the HDD
     /// @param block block index
@@ -182,9 +376,44 @@ class HDD : public Disk {
     /*Sectors_track: return number of sectors in the track num_track
     num_track is the numero of the track the innermost_track having numero 0 ...*/
     uint64 sectors_track(uint32 num_track) const;
+
+    /// @brief sector number from which decode() counts the sectors of track
+    ///        @a track: the start of the next track minus that track's size,
+    ///        as the original linear scan did. Negative on the inner tracks
+    ///        of geometries whose tracks grow by at least one sector.
+    int64 sector_base(uint32 track) const;
+
     ///Sectors_surface: return the number of sectors per surface
     uint64 sectors_surface(void) const;
 
+    /// @brief common read/write path: time to transfer @a nblocks blocks
+    ///        starting at @a block. The cost of the full tracks crossed by the
+    ///        request is computed in constant time from the prefix tables.
+    ///        The cache, however, is still accessed once per block (and, in
+    ///        write-back mode, every written block is marked dirty), so with
+    ///        a cache a request costs O(nblocks) to simulate; only LRU
+    ///        inserts just the blocks it keeps (see PolicyCache::put_range()).
+    /// @param ts timestamp of the event
+    /// @param block logical disk block index
+    /// @param nblocks number of blocks to transfer
+    /// @param write true for write accesses (uses write_time())
+    /// @retval time when the access ends (ts + latency of access)
+    double transfer(double ts, uint64 block, uint64 nblocks, bool write);
+
+    /// @brief read through the cache, with readahead
+    /// @retval time when the access ends or a negative value on failure
+    double cached_read(double ts, uint64 block, uint64 nblocks);
+
+    /// @brief move the heads to @a block and transfer @a nblocks blocks,
+    ///        bypassing the cache
+    /// @retval time when the access ends or a negative value on failure
+    double media_access(double ts, uint64 block, uint64 nblocks, bool write);
+
+    /// @brief write the next run of dirty blocks to the disk
+    /// @param ts time the write starts
+    /// @retval time the write ends
+    double destage(double ts);
+
     // add more protected methods as necessary
 };
 
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief log-linear latency histogram
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+
+#include "hist.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// LatencyHistogram
+//
+LatencyHistogram::LatencyHistogram(void)
+  : _count(index(MAX_VALUE)+1, 0), _n(0), _sum(0), _min(~0ULL), _max(0)
+{
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &h)
+{
+  for (size_t i=0; i<_count.size(); i++) _count[i] += h._count[i];
+  _n += h._n;
+  _sum += h._sum;
+  if (h._min < _min) _min = h._min;
+  if (h._max > _max) _max = h._max;
+}
+
+uint64 LatencyHistogram::count(void) const
+{
+  return _n;
+}
+
+double LatencyHistogram::min(void) const
+{
+  return _n > 0 ? _min*1e-9 : 0.0;
+}
+
+double LatencyHistogram::max(void) const
+{
+  return _max*1e-9;
+}
+
+double LatencyHistogram::mean(void) const
+{
+  return _n > 0 ? (double)_sum/_n*1e-9 : 0.0;
+}
+
+uint64 LatencyHistogram::lowest(size_t i)
+{
+  if (i < 2*HALF) return i;
+
+  // bucket i = shift*HALF + sub with HALF <= sub < 2*HALF
+  uint64 shift = i/HALF - 1;
+  uint64 sub = i - shift*HALF;
+  return sub << shift;
+}
+
+uint64 LatencyHistogram::highest(size_t i)
+{
+  return lowest(i+1) - 1;
+}
+
+double LatencyHistogram::percentile(double p) const
+{
+  if (_n == 0) return 0.0;
+
+  // rank of the value, 1.._n
+  uint64 rank = (uint64)ceil(p/100.0*_n);
+  if (rank < 1) rank = 1;
+  if (rank > _n) rank = _n;
+
+  uint64 seen = 0;
+  for (size_t i=0; i<_count.size(); i++) {
+    seen += _count[i];
+    if (seen >= rank) {
+      uint64 v = highest(i);
+      return (v < _max ? v : _max)*1e-9;
+    }
+  }
+
+  return max();
+}
+
+void LatencyHistogram::dump(ostream &out, const char *label) const
+{
+  for (size_t i=0; i<_count.size(); i++) {
+    if (_count[i] == 0) continue;
+    out << label << "," << lowest(i) << "," << highest(i) << ","
+        << _count[i] << "\n";
+  }
+}
+
+void LatencyHistogram::save(CheckpointWriter &out) const
+{
+  uint32 n = _count.size();
+
+  out.put(n);
+  out.put_array(&_count[0], n);
+  out.put(_n);
+  out.put(_sum);
+  out.put(_min);
+  out.put(_max);
+}
+
+bool LatencyHistogram::restore(CheckpointReader &in)
+{
+  uint32 n;
+
+  if (!in.get(n)) return false;
+  if (n != _count.size()) return in.fail("the histogram size differs");
+
+  return in.get_array(&_count[0], n) && in.get(_n) && in.get(_sum) &&
+         in.get(_min) && in.get(_max);
+}
@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief log-linear latency histogram
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_HIST_H__
+#define __CA_HIST_H__
+
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+#include "checkpoint.h"
+using namespace std;
+
+#define HIST_SUB_BITS  9            ///< log2 of sub-buckets per power of two
+#define HIST_MAX_BITS  48           ///< values up to 2^48 ns (~78 hours)
+
+//------------------------------------------------------------------------------
+/// @brief latency histogram with log-linear buckets (HDR-style)
+///
+/// Latencies are recorded in nanoseconds. Values below 2^HIST_SUB_BITS have
+/// their own bucket; above, every power of two is split into
+/// 2^(HIST_SUB_BITS-1) linear sub-buckets, so a bucket is never wider than
+/// 1/256 of its values. Recording is a shift and an increment; the memory
+/// is fixed (about 80 KB). Counts, sum, minimum and maximum are integers,
+/// so merging histograms is exact and independent of the order.
+///
+class LatencyHistogram {
+  public:
+    /// @brief constructor
+    LatencyHistogram(void);
+
+    /// @brief record a latency of @a seconds (negative values count as 0)
+    void record(double seconds)
+    {
+      uint64 v = seconds > 0 ? (uint64)(seconds*1e9 + 0.5) : 0;
+      if (v > MAX_VALUE) v = MAX_VALUE;
+
+      _count[index(v)]++;
+      _n++;
+      _sum += v;
+      if (v < _min) _min = v;
+      if (v > _max) _max = v;
+    }
+
+    /// @brief add the values recorded in @a h
+    void merge(const LatencyHistogram &h);
+
+    /// @name statistics (in seconds)
+    /// @{
+
+    /// @brief number of recorded values
+    uint64 count(void) const;
+
+    /// @brief smallest value
+    double min(void) const;
+
+    /// @brief largest value
+    double max(void) const;
+
+    /// @brief mean value
+    double mean(void) const;
+
+    /// @brief value below or at which @a p percent of the values lie (upper
+    ///        bound of the bucket, at most max())
+    double percentile(double p) const;
+
+    /// @}
+
+    /// @brief write the non-empty buckets as CSV records
+    ///        "<label>,<from_ns>,<to_ns>,<count>" (to_ns inclusive)
+    void dump(ostream &out, const char *label) const;
+
+    /// @brief write the buckets and totals to checkpoint @a out
+    void save(CheckpointWriter &out) const;
+
+    /// @brief replace the recorded values with those read from checkpoint
+    ///        @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    static const uint64 HALF = 1ULL << (HIST_SUB_BITS-1);
+    static const uint64 MAX_VALUE = (1ULL << HIST_MAX_BITS) - 1;
+
+    vector<uint64> _count;          ///< bucket counts
+    uint64 _n;                      ///< number of values
+    uint64 _sum;                    ///< sum of values (ns)
+    uint64 _min;                    ///< smallest value (ns)
+    uint64 _max;                    ///< largest value (ns)
+
+    /// @brief bucket of value @a v
+    static size_t index(uint64 v)
+    {
+      // shift so that v >> shift has HIST_SUB_BITS significant bits
+      int msb = 63 - __builtin_clzll(v | 1);
+      int shift = msb < HIST_SUB_BITS ? 0 : msb - HIST_SUB_BITS + 1;
+      return (size_t)shift*HALF + (size_t)(v >> shift);
+    }
+
+    /// @brief smallest value of bucket @a i
+    static uint64 lowest(size_t i);
+
+    /// @brief largest value of bucket @a i
+    static uint64 highest(size_t i);
+};
+
+#endif // __CA_HIST_H__
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief timestamp-ordered merge of several traces (multi-tenant replay)
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+#include "bz2trace.h"
+#include "merge.h"
+#include "workload.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// MergedTraceReader
+//
+MergedTraceReader* MergedTraceReader::open(const vector<char*> &paths,
+                                           uint64 stride, uint32 nthreads)
+{
+  if ((paths.size() == 0) || (paths.size() > MAX_TENANTS)) {
+    cout << "Merging requires 1.." << MAX_TENANTS << " traces." << endl;
+    return NULL;
+  }
+
+  MergedTraceReader *m = new MergedTraceReader();
+  uint32 nbz2 = 0;
+  for (size_t i=0; i<paths.size(); i++) {
+    string spec = paths[i];
+    size_t sep = spec.find(TENANT_SEPARATOR);
+
+    Tenant t;
+    t.in = NULL;
+    t.name = spec.substr(0, sep);
+    t.offset = 0;
+    t.scale = 1;
+    t.base = i * stride;
+    t.first = 0;
+    t.started = false;
+
+    if ((sep != string::npos) && !parse(spec.substr(sep+1), &t)) {
+      delete m;
+      return NULL;
+    }
+    if (!WorkloadGenerator::is_spec(t.name.c_str()) &&
+        Bz2TraceReader::is_bz2(t.name.c_str())) nbz2++;
+    m->_tenants.push_back(t);
+  }
+
+  if (nbz2 > MAX_BZ2_TENANTS) {
+    cout << "Merging supports at most " << MAX_BZ2_TENANTS
+         << " bzip2-compressed traces." << endl;
+    delete m;
+    return NULL;
+  }
+
+  // the bzip2 traces share the decompression threads and the queue
+  if (nthreads == 0) nthreads = max(1U, thread::hardware_concurrency());
+  nthreads = max(1U, nthreads / max(1U, nbz2));
+  uint32 queue = max(2U, MERGE_BZ2_QUEUE / max(1U, nbz2));
+
+  for (size_t i=0; i<m->_tenants.size(); i++) {
+    Tenant &t = m->_tenants[i];
+    t.in = TraceReader::open(t.name.c_str(), nthreads, queue);
+    if (t.in == NULL) {
+      delete m;
+      return NULL;
+    }
+  }
+
+  for (uint32 t=0; t<m->_tenants.size(); t++) m->advance(t);
+
+  return m;
+}
+
+MergedTraceReader::MergedTraceReader(void)
+  : _last(0), _pending(false)
+{
+}
+
+MergedTraceReader::~MergedTraceReader(void)
+{
+  for (size_t t=0; t<_tenants.size(); t++) delete _tenants[t].in;
+}
+
+uint32 MergedTraceReader::tenants(void) const
+{
+  return _tenants.size();
+}
+
+const char* MergedTraceReader::name(uint32 t) const
+{
+  return _tenants[t].name.c_str();
+}
+
+bool MergedTraceReader::next(TraceRequest *r)
+{
+  // the previous tenant reads ahead only now, so its comment stays valid
+  if (_pending) advance(_last);
+  _pending = false;
+
+  if (_heap.empty()) return false;
+
+  pop_heap(_heap.begin(), _heap.end(), greater<pair<double, uint32> >());
+  _last = _heap.back().second;
+  _heap.pop_back();
+  _pending = true;
+
+  *r = _tenants[_last].head;
+  return true;
+}
+
+char* MergedTraceReader::comment(void)
+{
+  if (!_pending) return TraceReader::comment();
+  return _tenants[_last].in->comment();
+}
+
+bool MergedTraceReader::failed(void) const
+{
+  for (size_t t=0; t<_tenants.size(); t++) {
+    if (_tenants[t].in->failed()) return true;
+  }
+  return false;
+}
+
+bool MergedTraceReader::parse(const string &options, Tenant *t)
+{
+  size_t p = 0;
+
+  while (p < options.size()) {
+    size_t e = options.find(',', p);
+    if (e == string::npos) e = options.size();
+    string item = options.substr(p, e-p);
+    p = e+1;
+    if (item.empty()) continue;
+
+    size_t eq = item.find('=');
+    string key = item.substr(0, eq);
+    double d = 0;
+    bool ok = (eq != string::npos) && parse_number(item.substr(eq+1), &d);
+
+    if (key == "offset") { t->offset = d; ok = ok && (d >= 0); } else
+    if (key == "base")   { t->base = (uint64)d; ok = ok && (d >= 0); } else
+    if (key == "scale")  { t->scale = d; ok = ok && (d > 0); } else {
+      cout << "Unknown tenant option '" << key << "'." << endl;
+      return false;
+    }
+
+    if (!ok) {
+      cout << "Invalid tenant option '" << item << "'." << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void MergedTraceReader::advance(uint32 t)
+{
+  Tenant &ten = _tenants[t];
+  TraceRequest &r = ten.head;
+
+  if (!ten.in->next(&r)) return;
+
+  if (!ten.started) {
+    ten.first = r.ts;
+    ten.started = true;
+  }
+  r.ts = ten.offset + (r.ts - ten.first) / ten.scale;
+  r.address += ten.base;
+
+  _heap.push_back(make_pair(r.ts, t));
+  push_heap(_heap.begin(), _heap.end(), greater<pair<double, uint32> >());
+}
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief timestamp-ordered merge of several traces (multi-tenant replay)
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_MERGE_H__
+#define __CA_MERGE_H__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "trace.h"
+using namespace std;
+
+#define TENANT_SEPARATOR '@'        ///< separates a trace from its options
+#define MAX_TENANTS      4096       ///< max. number of merged traces
+#define MAX_BZ2_TENANTS  64         ///< max. number of merged bzip2 traces
+#define MERGE_BZ2_QUEUE  16         ///< batches buffered by all bzip2 traces
+
+//------------------------------------------------------------------------------
+/// @brief several traces replayed together, one tenant per trace
+///
+/// Every trace is read by its own TraceReader, so the traces are streamed
+/// and never loaded completely. A bzip2 trace has its own producer thread
+/// and decompressor state of a few MB, so at most MAX_BZ2_TENANTS of the
+/// traces may be compressed; they split the decompression threads and a
+/// queue of MERGE_BZ2_QUEUE batches of parsed requests among them. The merged reader keeps the next request of
+/// every trace in a min-heap ordered by timestamp (ties: lower tenant
+/// first) and returns the root; the tenant it came from then reads its next
+/// request when the merged reader is advanced.
+///
+/// A trace may be followed by TENANT_SEPARATOR and comma-separated options,
+/// e.g. "traces/vm.shuffle1.bz2@offset=60,base=100g,scale=2":
+/// - offset  start time of the tenant in seconds (0)
+/// - base    byte offset added to every address (tenant index x stride)
+/// - scale   rate scale; inter-arrival times are divided by it (1)
+///
+/// The timestamps of a tenant are relative to its first request, so traces
+/// recorded at different times start together unless they are offset:
+///   ts' = offset + (ts - first ts of the trace) / scale
+/// base accepts the suffixes k, m, g. Tenants share the disk and its cache;
+/// without a base they also share the address space.
+///
+class MergedTraceReader : public TraceReader {
+  public:
+    /// @brief open traces
+    /// @param paths traces or workload specs, each optionally followed by
+    ///        tenant options
+    /// @param stride default base of tenant i is i x @a stride bytes
+    /// @param nthreads decompression threads shared by the bzip2 traces
+    ///        (0: number of cores; every bzip2 trace gets at least one)
+    /// @retval MergedTraceReader instance or NULL on failure
+    static MergedTraceReader* open(const vector<char*> &paths, uint64 stride,
+                                   uint32 nthreads=0);
+
+    /// @brief destructor; closes the traces
+    virtual ~MergedTraceReader(void);
+
+    virtual bool next(TraceRequest *r);
+
+    /// @brief comment of the last request; valid until the next call to
+    ///        next()
+    virtual char* comment(void);
+
+    /// @brief true if the trace of any tenant failed
+    virtual bool failed(void) const;
+
+    /// @brief tenant of the last request
+    uint32 tenant(void) const { return _last; }
+
+    /// @brief number of tenants
+    uint32 tenants(void) const;
+
+    /// @brief trace of tenant @a t (without its options)
+    const char* name(uint32 t) const;
+
+  protected:
+    ///@brief one merged trace
+    typedef struct {
+      TraceReader *in;              ///< reader
+      string name;                  ///< trace path
+      double offset;                ///< start time
+      double scale;                 ///< rate scale
+      uint64 base;                  ///< address offset
+      double first;                 ///< timestamp of the first request
+      bool   started;               ///< first request has been read
+      TraceRequest head;            ///< next request (in the heap)
+    } Tenant;
+
+    vector<Tenant> _tenants;        ///< tenants
+    vector<pair<double, uint32> > _heap; ///< next timestamp, tenant
+    uint32 _last;                   ///< tenant of the last request
+    bool   _pending;                ///< _last has yet to read ahead
+
+    /// @brief constructor
+    MergedTraceReader(void);
+
+    /// @brief parse the options of tenant @a t
+    /// @retval true on success
+    static bool parse(const string &options, Tenant *t);
+
+    /// @brief read the next request of tenant @a t into the heap
+    void advance(uint32 t);
+};
+
+#endif // __CA_MERGE_H__
@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief single-pass LRU miss-ratio curves from stack distances
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include "mrc.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// StackDistance
+//
+StackDistance::StackDistance(uint32 max_size)
+  : _max(max_size), _accesses(0), _cold(0), _now(0), _live(0)
+{
+  _hist.assign((size_t)_max+1, 0);
+  _tree.assign(1024, 0);
+}
+
+StackDistance::~StackDistance(void)
+{
+}
+
+void StackDistance::access(uint64 block, bool count)
+{
+  uint64 d = reference(block);
+
+  if (!count) return;
+
+  _accesses++;
+  if (d == COLD) _cold++;
+  else _hist[d < _max ? d : _max]++;
+}
+
+uint64 StackDistance::reference(uint64 block)
+{
+  uint64 d = COLD;
+
+  if (_now == _tree.size()) compact();
+
+  pair<unordered_map<uint64, uint64>::iterator, bool> res =
+    _last.insert(make_pair(block, _now));
+
+  if (!res.second) {
+    // marks after prev = distinct blocks referenced since
+    uint64 prev = res.first->second;
+    d = _live - prefix(prev);
+    add(prev, -1);
+    _live--;
+    res.first->second = _now;
+  }
+
+  add(_now, 1);
+  _live++;
+  _now++;
+
+  return d;
+}
+
+void StackDistance::forget(uint64 block)
+{
+  unordered_map<uint64, uint64>::iterator it = _last.find(block);
+
+  if (it == _last.end()) return;
+
+  add(it->second, -1);
+  _live--;
+  _last.erase(it);
+}
+
+uint64 StackDistance::accesses(void) const
+{
+  return _accesses;
+}
+
+uint64 StackDistance::distinct(void) const
+{
+  return _last.size();
+}
+
+void StackDistance::curve(vector<uint64> &misses) const
+{
+  //
+  // a cache of c blocks misses on cold references and distances >= c
+  //
+  misses.assign((size_t)_max+1, 0);
+  uint64 m = _cold + _hist[_max];
+  for (uint32 c=_max; ; c--) {
+    misses[c] = m;
+    if (c == 0) break;
+    m += _hist[c-1];
+  }
+}
+
+void StackDistance::add(uint64 t, int v)
+{
+  for (uint64 i=t+1; i<=_tree.size(); i+=i&(~i+1)) _tree[i-1] += v;
+}
+
+uint64 StackDistance::prefix(uint64 t) const
+{
+  uint64 s = 0;
+  for (uint64 i=t+1; i>0; i-=i&(~i+1)) s += _tree[i-1];
+  return s;
+}
+
+void StackDistance::compact(void)
+{
+  //
+  // order the blocks by their last reference and renumber them densely
+  //
+  vector<pair<uint64, uint64> > order;
+  order.reserve(_last.size());
+  for (unordered_map<uint64, uint64>::const_iterator it=_last.begin();
+       it!=_last.end(); it++) {
+    order.push_back(make_pair(it->second, it->first));
+  }
+  sort(order.begin(), order.end());
+
+  for (size_t i=0; i<order.size(); i++) _last[order[i].second] = i;
+
+  //
+  // rebuild the tree with room for as many new references as there are
+  // live ones (at least doubling the time axis before the next compaction)
+  //
+  size_t size = max((size_t)1024, 2*order.size());
+  _tree.assign(size, 0);
+  for (size_t i=1; i<=size; i++) {
+    if (i <= order.size()) _tree[i-1] += 1;
+    size_t j = i + (i&(~i+1));
+    if (j <= size) _tree[j-1] += _tree[i-1];
+  }
+  _now = order.size();
+  assert(_live == order.size());
+}
+
+//------------------------------------------------------------------------------
+// ShardsMRC
+//
+ShardsMRC::ShardsMRC(uint32 max_size, double rate, uint32 max_samples)
+  : _max(max_size), _max_samples(max_samples), _accesses(0), _sampled(0),
+    _cold(0), _sd(1)
+{
+  assert((rate > 0) && (rate <= 1));
+
+  _threshold = (uint64)(rate*P);
+  if (_threshold == 0) _threshold = 1;
+  _hist.assign((size_t)_max+1, 0.0);
+
+  for (uint64 c=1; c<_max; c*=2) _sizes.push_back((uint32)c);
+  _sizes.push_back(_max);
+}
+
+ShardsMRC::~ShardsMRC(void)
+{
+}
+
+uint64 ShardsMRC::hash(uint64 block)
+{
+  // splitmix64 finalizer
+  uint64 z = block + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z = z ^ (z >> 31);
+  return z & (P-1);
+}
+
+void ShardsMRC::access(uint64 block, bool count)
+{
+  if (count) _accesses++;
+
+  uint64 h = hash(block);
+  if (h >= _threshold) return;
+
+  uint64 d = _sd.reference(block);
+
+  if (count) {
+    size_t bucket = _max;
+    _sampled++;
+    if (d == StackDistance::COLD) {
+      _cold++;
+    } else {
+      double scaled = (double)d * P / _threshold;
+      if (scaled < _max) bucket = (size_t)scaled;
+      _hist[bucket]++;
+    }
+    this->count(block, bucket);
+  }
+
+  if ((_max_samples == 0) || (d != StackDistance::COLD)) return;
+
+  //
+  // fixed size: lower the threshold until the new block fits
+  //
+  _tracked.insert(make_pair(h, block));
+  while (_tracked.size() > _max_samples) {
+    uint64 t = _tracked.rbegin()->first;
+    while (!_tracked.empty() && (_tracked.rbegin()->first == t)) {
+      _sd.forget(_tracked.rbegin()->second);
+      drop(_tracked.rbegin()->second);
+      _tracked.erase(--_tracked.end());
+    }
+
+    double scale = (double)t / _threshold;
+    for (size_t i=0; i<_hist.size(); i++) _hist[i] *= scale;
+    _cold *= scale;
+    _sampled *= scale;
+    _threshold = t;
+  }
+}
+
+double ShardsMRC::rate(void) const
+{
+  return (double)_threshold / P;
+}
+
+uint64 ShardsMRC::samples(void) const
+{
+  return _max_samples > 0 ? _tracked.size() : 0;
+}
+
+uint64 ShardsMRC::accesses(void) const
+{
+  return _accesses;
+}
+
+void ShardsMRC::curve(vector<double> &miss_rate, vector<double> &error) const
+{
+  miss_rate.assign((size_t)_max+1, 0.0);
+  error.assign((size_t)_max+1, 0.0);
+  if (_sampled <= 0) return;
+
+  //
+  // SHARDS-adj: attribute the difference between the expected and the
+  // actual number of sampled references to distance 0
+  //
+  double total = _sampled;
+  double first = _hist[0];
+  if (_max_samples == 0) {
+    double expected = (double)_accesses * rate();
+    first += expected - _sampled;
+    total = expected;
+  }
+
+  //
+  // scaled distances are multiples of 1/R: below that, the estimate is not
+  // resolved and the interval bounds nothing
+  //
+  double resolution = 1.0 / rate();
+
+  double m = _cold + _hist[_max];
+  for (uint32 c=_max; ; c--) {
+    double r = m / total;
+    if (r < 0) r = 0;
+    if (r > 1) r = 1;
+    miss_rate[c] = r;
+    if (c == 0) break;
+    m += (c-1 == 0) ? first : _hist[c-1];
+  }
+
+  //
+  // variance of sampling whole blocks at the counted sizes
+  //
+  size_t k = _sizes.size();
+  vector<double> var(k, 0.0);
+  unordered_map<uint64, uint32>::const_iterator it;
+  for (it=_slot.begin(); it!=_slot.end(); it++) {
+    const uint32 *n = &_counts[(size_t)it->second*(k+1)];
+    for (size_t j=0; j<k; j++) {
+      double x = n[j+1] - miss_rate[_sizes[j]]*n[0];
+      var[j] += x*x;
+    }
+  }
+  for (size_t j=0; j<k; j++) var[j] *= (1 - rate()) / (total*total);
+
+  //
+  // 95% interval, with the variance interpolated in log(size) between the
+  // counted sizes
+  //
+  size_t j = 0;
+  for (uint32 c=1; c<=_max; c++) {
+    if (c < resolution) {
+      error[c] = -1.0;
+      continue;
+    }
+    while ((j+1 < k) && (_sizes[j+1] <= c)) j++;
+    double v = var[j];
+    if ((j+1 < k) && (_sizes[j] < c)) {
+      double t = log((double)c/_sizes[j]) / log((double)_sizes[j+1]/_sizes[j]);
+      v += t * (var[j+1] - var[j]);
+    }
+    error[c] = 1.96*sqrt(v);
+  }
+  error[0] = -1.0;
+}
+
+void ShardsMRC::count(uint64 block, size_t bucket)
+{
+  size_t k = _sizes.size() + 1;
+  uint32 s;
+
+  unordered_map<uint64, uint32>::iterator it = _slot.find(block);
+  if (it != _slot.end()) {
+    s = it->second;
+  } else if (!_free.empty()) {
+    s = _free.back();
+    _free.pop_back();
+    _slot[block] = s;
+  } else {
+    s = (uint32)(_counts.size() / k);
+    _counts.resize(_counts.size() + k, 0);
+    _slot[block] = s;
+  }
+
+  uint32 *n = &_counts[(size_t)s*k];
+  n[0]++;
+  for (size_t j=0; (j+1<k) && (_sizes[j]<=bucket); j++) n[j+1]++;
+}
+
+void ShardsMRC::drop(uint64 block)
+{
+  unordered_map<uint64, uint32>::iterator it = _slot.find(block);
+  if (it == _slot.end()) return;
+
+  size_t k = _sizes.size() + 1;
+  fill(_counts.begin() + (size_t)it->second*k,
+       _counts.begin() + ((size_t)it->second+1)*k, 0);
+  _free.push_back(it->second);
+  _slot.erase(it);
+}
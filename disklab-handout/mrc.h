@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief single-pass LRU miss-ratio curves from stack distances
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_MRC_H__
+#define __CA_MRC_H__
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+using namespace std;
+
+#define MAX_MRC_SIZE     (1 << 22)  ///< max. cache size of a miss-ratio curve
+
+//------------------------------------------------------------------------------
+/// @brief LRU stack (reuse) distance histogram
+///
+/// The stack distance of a reference is the number of distinct blocks
+/// referenced since the previous reference to the same block; a reference
+/// hits in an LRU cache of c blocks iff its distance is < c. One pass over a
+/// trace thus yields the miss ratio of every cache size.
+///
+/// Every block's most recent reference is marked in a Fenwick tree indexed
+/// by reference time, so the distance is the number of marks after the
+/// block's previous reference: O(log n) per reference. When the time axis
+/// fills up, the live marks are renumbered, keeping the memory proportional
+/// to the number of distinct blocks.
+///
+class StackDistance {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param max_size largest cache size of interest; distances >= max_size
+    ///        are counted together
+    StackDistance(uint32 max_size);
+
+    /// @brief destructor
+    ~StackDistance(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief reference @a block
+    /// @param block block number
+    /// @param count true: a BlockCache::get() that counts as hit/miss,
+    ///        false: a BlockCache::put() that only updates recency
+    void access(uint64 block, bool count=true);
+
+    /// @brief reference @a block without updating the histogram
+    /// @retval stack distance of the reference or COLD
+    uint64 reference(uint64 block);
+
+    /// @brief remove @a block from the LRU stack
+    void forget(uint64 block);
+
+    static const uint64 COLD = ~0ULL; ///< distance of first references
+
+    /// @brief number of counted references
+    uint64 accesses(void) const;
+
+    /// @brief number of distinct blocks referenced
+    uint64 distinct(void) const;
+
+    /// @brief compute the number of misses of an LRU cache of every size
+    /// @param misses (output) misses[c] for c = 0..max_size
+    void curve(vector<uint64> &misses) const;
+
+    /// @}
+
+
+  protected:
+    uint32 _max;                    ///< largest cache size of interest
+    uint64 _accesses;               ///< counted references
+    uint64 _cold;                   ///< counted first references
+    vector<uint64> _hist;           ///< _hist[d]: counted refs at distance d
+                                    ///< (_hist[_max]: distance >= _max)
+
+    unordered_map<uint64, uint64> _last; ///< block -> time of last reference
+    vector<uint32> _tree;           ///< Fenwick tree over reference times
+    uint64 _now;                    ///< next reference time
+    uint64 _live;                   ///< number of marks in the tree
+
+    /// @brief add @a v to position @a t
+    void   add(uint64 t, int v);
+
+    /// @brief number of marks at positions <= @a t
+    uint64 prefix(uint64 t) const;
+
+    /// @brief renumber the live marks to 0.._live-1 and resize the tree
+    void   compact(void);
+};
+
+//------------------------------------------------------------------------------
+/// @brief approximate LRU miss-ratio curve by spatial sampling (SHARDS)
+///
+/// Only blocks whose hash falls below a threshold T (out of P = 2^24) are
+/// tracked, i.e., a fraction R = T/P of the blocks. Stack distances measured
+/// among the sampled blocks are scaled by 1/R. Memory is proportional to
+/// the number of sampled blocks.
+///
+/// In the fixed-size variant, at most max_samples blocks are tracked: when
+/// a new block would exceed the limit, T is lowered to the largest tracked
+/// hash and the blocks at that hash are dropped; the counts collected so far
+/// are rescaled to the new rate.
+///
+/// The fixed-rate variant corrects the first histogram bucket by the
+/// difference between expected and actual sampled references (SHARDS-adj).
+///
+/// The reported error bound is a 95% interval of the spatial sampling: the
+/// references of a block are sampled together, so a binomial interval over
+/// the sampled references is too tight, most of all at low rates. The
+/// variance of the estimated miss ratio r at cache size c is estimated as
+/// (1-R) * sum_i (m_i - r*n_i)^2 / S^2 over the sampled blocks i, where n_i
+/// are the references and m_i the misses of block i and S the sampled
+/// references. m_i is counted per block at the powers of two up to max_size,
+/// and the variance is interpolated in between. The bound only covers the
+/// sampling noise: cache sizes below 1/R blocks are below the resolution of
+/// the scaled distances and get no bound.
+///
+class ShardsMRC {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param max_size largest cache size of interest
+    /// @param rate (initial) sampling rate, 0 < rate <= 1
+    /// @param max_samples maximum number of tracked blocks (0: fixed rate)
+    ShardsMRC(uint32 max_size, double rate, uint32 max_samples=0);
+
+    /// @brief destructor
+    ~ShardsMRC(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief reference @a block (see StackDistance::access())
+    void access(uint64 block, bool count=true);
+
+    /// @brief current sampling rate
+    double rate(void) const;
+
+    /// @brief number of tracked blocks
+    uint64 samples(void) const;
+
+    /// @brief number of counted references (sampled or not)
+    uint64 accesses(void) const;
+
+    /// @brief estimate the miss ratio of every cache size
+    /// @param miss_rate (output) miss_rate[c] for c = 0..max_size
+    /// @param error (output) half-width of the 95% confidence interval, or
+    ///        -1 for cache sizes below 1/R (unreliable)
+    void curve(vector<double> &miss_rate, vector<double> &error) const;
+
+    /// @}
+
+
+  protected:
+    static const uint64 P = 1ULL << 24; ///< hash modulus
+
+    uint32 _max;                    ///< largest cache size of interest
+    uint64 _threshold;              ///< sample blocks with hash < _threshold
+    uint32 _max_samples;            ///< fixed-size limit (0: fixed rate)
+    uint64 _accesses;               ///< counted references
+    double _sampled;                ///< counted sampled references (rescaled)
+    double _cold;                   ///< counted sampled first references
+    vector<double> _hist;           ///< scaled distance histogram
+    StackDistance _sd;              ///< LRU stack of the sampled blocks
+    set<pair<uint64, uint64> > _tracked; ///< (hash, block), fixed size only
+
+    vector<uint32> _sizes;          ///< cache sizes with per-block misses
+    unordered_map<uint64, uint32> _slot; ///< sampled block -> slot
+    vector<uint32> _counts;         ///< per slot: counted references, then
+                                    ///< the misses at each of _sizes
+    vector<uint32> _free;           ///< unused slots
+
+    /// @brief hash of @a block in [0, P)
+    static uint64 hash(uint64 block);
+
+    /// @brief count a reference to sampled @a block at scaled distance
+    ///        @a bucket (_max: cold or beyond _max) for the error bound
+    void count(uint64 block, size_t bucket);
+
+    /// @brief stop counting the references of @a block
+    void drop(uint64 block);
+};
+
+#endif // __CA_MRC_H__
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief work-stealing thread pool
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include "pool.h"
+using namespace std;
+
+/// @brief pool and worker id of the calling thread (NULL: not a worker)
+static thread_local WorkPool *tl_pool = NULL;
+static thread_local uint32 tl_id = 0;
+
+WorkPool::WorkPool(uint32 nthreads)
+  : _queued(0), _pending(0), _stop(false), _next(0), _steals(0)
+{
+  if (nthreads == 0) nthreads = thread::hardware_concurrency();
+  if (nthreads == 0) nthreads = 1;
+
+  for (uint32 t=0; t<nthreads; t++) _queue.push_back(new Queue);
+  for (uint32 t=0; t<nthreads; t++) {
+    _worker.push_back(thread(&WorkPool::work, this, t));
+  }
+}
+
+WorkPool::~WorkPool(void)
+{
+  wait();
+  {
+    lock_guard<mutex> l(_lock);
+    _stop = true;
+  }
+  _work.notify_all();
+  for (size_t t=0; t<_worker.size(); t++) _worker[t].join();
+  for (size_t t=0; t<_queue.size(); t++) delete _queue[t];
+}
+
+uint32 WorkPool::threads(void) const
+{
+  return _worker.size();
+}
+
+uint64 WorkPool::steals(void) const
+{
+  return _steals;
+}
+
+void WorkPool::submit(Task task)
+{
+  uint32 q = tl_pool == this ? tl_id : _next++ % _queue.size();
+
+  // count first so that _queued never drops below zero
+  {
+    lock_guard<mutex> l(_lock);
+    _pending++;
+    _queued++;
+  }
+  {
+    lock_guard<mutex> l(_queue[q]->lock);
+    _queue[q]->tasks.push_back(task);
+  }
+  _work.notify_one();
+}
+
+void WorkPool::wait(void)
+{
+  unique_lock<mutex> l(_lock);
+  _idle.wait(l, [this] { return _pending == 0; });
+}
+
+bool WorkPool::take(uint32 id, Task *task)
+{
+  uint32 n = _queue.size();
+
+  for (uint32 i=0; i<n; i++) {
+    Queue *q = _queue[(id + i) % n];
+    lock_guard<mutex> l(q->lock);
+
+    if (q->tasks.empty()) continue;
+    if (i == 0) {
+      *task = q->tasks.back();
+      q->tasks.pop_back();
+    } else {
+      *task = q->tasks.front();
+      q->tasks.pop_front();
+      _steals++;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+void WorkPool::work(uint32 id)
+{
+  tl_pool = this;
+  tl_id = id;
+
+  while (true) {
+    Task task;
+
+    if (take(id, &task)) {
+      {
+        lock_guard<mutex> l(_lock);
+        _queued--;
+      }
+      task();
+
+      lock_guard<mutex> l(_lock);
+      if (--_pending == 0) _idle.notify_all();
+      continue;
+    }
+
+    unique_lock<mutex> l(_lock);
+    _work.wait(l, [this] { return _stop || (_queued > 0); });
+    if (_stop && (_queued == 0)) return;
+  }
+}
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief work-stealing thread pool
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_POOL_H__
+#define __CA_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief work-stealing thread pool
+///
+/// Every worker owns a task deque. Tasks submitted by a worker go to the back
+/// of its own deque and are run LIFO; tasks submitted from outside are
+/// distributed round-robin. An idle worker steals from the front of the
+/// other workers' deques.
+///
+class WorkPool {
+  public:
+    typedef function<void(void)> Task;  ///< unit of work
+
+    /// @brief constructor; starts the workers
+    /// @param nthreads number of worker threads (0: number of cores)
+    WorkPool(uint32 nthreads);
+
+    /// @brief destructor; waits for all tasks and stops the workers
+    ~WorkPool(void);
+
+    /// @brief add a task (may be called from within a task)
+    void submit(Task task);
+
+    /// @brief wait until all submitted tasks (and tasks they submitted) ran
+    void wait(void);
+
+    /// @brief number of worker threads
+    uint32 threads(void) const;
+
+    /// @brief number of tasks run by a worker other than the owner
+    uint64 steals(void) const;
+
+  private:
+    ///@brief per-worker task deque
+    typedef struct {
+      mutex lock;                   ///< protects tasks
+      deque<Task> tasks;            ///< pending tasks
+    } Queue;
+
+    vector<Queue*> _queue;          ///< task deques, one per worker
+    vector<thread> _worker;         ///< worker threads
+    mutex  _lock;                   ///< protects the counters below
+    condition_variable _work;       ///< tasks available or stop
+    condition_variable _idle;       ///< all tasks done
+    uint64 _queued;                 ///< tasks in the deques
+    uint64 _pending;                ///< tasks submitted but not finished
+    bool   _stop;                   ///< workers shall terminate
+    atomic<uint32> _next;           ///< round-robin deque for submit()
+    atomic<uint64> _steals;         ///< number of stolen tasks
+
+    /// @brief take a task: own deque first, then steal
+    bool take(uint32 id, Task *task);
+
+    /// @brief worker thread @a id
+    void work(uint32 id);
+
+    WorkPool(const WorkPool&);
+    WorkPool& operator=(const WorkPool&);
+};
+
+#endif // __CA_POOL_H__
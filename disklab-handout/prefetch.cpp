@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief sequential stream detection and readahead for the disk cache
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "prefetch.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Prefetcher
+//
+Prefetcher::Prefetcher(BlockCache *cache, uint64 nblocks)
+  : _cache(cache), _nblocks(nblocks), _stream(PREFETCH_STREAMS), _last(NULL),
+    _clock(0), _issued(0), _useful(0), _evicted(0)
+{
+  for (size_t i=0; i<_stream.size(); i++) _stream[i].valid = false;
+}
+
+Prefetcher::~Prefetcher(void)
+{
+}
+
+uint64 Prefetcher::issued(void) const
+{
+  return _issued;
+}
+
+uint64 Prefetcher::useful(void) const
+{
+  return _useful;
+}
+
+uint64 Prefetcher::wasted(void) const
+{
+  return _issued - _useful;
+}
+
+uint64 Prefetcher::evicted(void) const
+{
+  return _evicted;
+}
+
+double Prefetcher::accuracy(void) const
+{
+  return _issued > 0 ? (double)_useful / _issued : 0.0;
+}
+
+double Prefetcher::coverage(void) const
+{
+  uint64 misses = _cache->misses();
+  return _useful + misses > 0 ? (double)_useful / (_useful + misses) : 0.0;
+}
+
+PrefetchStream* Prefetcher::lookup(uint64 block, uint64 nblocks)
+{
+  PrefetchStream *victim = &_stream[0];
+
+  for (size_t i=0; i<_stream.size(); i++) {
+    PrefetchStream *s = &_stream[i];
+    if (!s->valid) {
+      if (victim->valid) victim = s;
+      continue;
+    }
+    if ((s->last <= block) && (block <= s->next)) return s;
+    if (victim->valid && (s->used < victim->used)) victim = s;
+  }
+
+  //
+  // new stream
+  //
+  victim->valid = true;
+  victim->sequential = false;
+  victim->last = block;
+  victim->next = block + nblocks;
+  victim->window = PREFETCH_INIT_WINDOW;
+  victim->pf_end = 0;
+
+  return victim;
+}
+
+uint64 Prefetcher::access(uint64 block, uint64 nblocks)
+{
+  PrefetchStream *s = lookup(block, nblocks);
+  uint64 end = block + nblocks;
+
+  // a stream is sequential once a read extends it
+  s->used = ++_clock;
+  s->last = block;
+  if (end > s->next) {
+    s->next = end;
+    s->sequential = true;
+  }
+  _last = s;
+
+  //
+  // consume the read-ahead blocks covered by this read
+  //
+  _consumed.clear();
+  uint64 consumed = _pending.erase(block, nblocks, &_consumed);
+  if (consumed > 0) {
+    uint64 cached = 0;
+    for (size_t i=0; i<_consumed.size(); i++) {
+      for (uint64 b=_consumed[i].first; b<_consumed[i].second; b++) {
+        if (_cache->has(b)) cached++;
+      }
+    }
+    _useful += cached;
+    _evicted += consumed - cached;
+
+    if (cached < consumed) {
+      s->window = max(s->window/2, (uint64)PREFETCH_MIN_WINDOW);
+    } else if (end >= s->pf_end) {
+      s->window = min(s->window*2, (uint64)PREFETCH_MAX_WINDOW);
+    }
+  }
+
+  if (!s->sequential || (end >= _nblocks)) return 0;
+  return min(s->window, _nblocks - end);
+}
+
+void Prefetcher::prefetched(uint64 block, uint64 nblocks)
+{
+  PrefetchStream *s = _last;
+
+  // blocks still pending from an earlier window are not counted again
+  _issued += _pending.insert(block, nblocks);
+
+  s->pf_end = max(s->pf_end, block + nblocks);
+  if (s->next < s->pf_end) s->next = s->pf_end;
+}
+
+void Prefetcher::save(CheckpointWriter &out) const
+{
+  uint32 n = _stream.size();
+  int32 last = _last != NULL ? _last - &_stream[0] : -1;
+
+  out.section("PREF");
+  out.put(n);
+  for (const PrefetchStream &s : _stream) {
+    out.put(s.last);
+    out.put(s.next);
+    out.put(s.window);
+    out.put(s.pf_end);
+    out.put(s.used);
+    out.put_bool(s.valid);
+    out.put_bool(s.sequential);
+  }
+  out.put(last);
+  out.put(_clock);
+  out.put(_issued);
+  out.put(_useful);
+  out.put(_evicted);
+  _pending.save(out);
+}
+
+bool Prefetcher::restore(CheckpointReader &in)
+{
+  uint32 n;
+  int32 last;
+
+  if (!in.section("PREF") || !in.get(n)) return false;
+  if (n != _stream.size()) return in.fail("the number of streams differs");
+  for (PrefetchStream &s : _stream) {
+    if (!in.get(s.last) || !in.get(s.next) || !in.get(s.window) ||
+        !in.get(s.pf_end) || !in.get(s.used) || !in.get_bool(s.valid) ||
+        !in.get_bool(s.sequential)) return false;
+  }
+  if (!in.get(last)) return false;
+  if ((last < -1) || (last >= (int32)n)) return in.fail("corrupt stream");
+  _last = last >= 0 ? &_stream[last] : NULL;
+
+  return in.get(_clock) && in.get(_issued) && in.get(_useful) &&
+         in.get(_evicted) && _pending.restore(in);
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief sequential stream detection and readahead for the disk cache
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_PREFETCH_H__
+#define __CA_PREFETCH_H__
+
+#include <vector>
+
+#include "types.h"
+#include "cache.h"
+using namespace std;
+
+#define PREFETCH_STREAMS     16     ///< number of tracked streams
+#define PREFETCH_MIN_WINDOW  4      ///< smallest readahead window (blocks)
+#define PREFETCH_INIT_WINDOW 16     ///< initial readahead window (blocks)
+#define PREFETCH_MAX_WINDOW  1024   ///< largest readahead window (blocks)
+
+///@brief state of one sequential stream
+typedef struct PrefetchStream {
+  uint64 last;                      ///< first block of the last request
+  uint64 next;                      ///< block following the stream so far
+  uint64 window;                    ///< readahead window (blocks)
+  uint64 pf_end;                    ///< end of the read-ahead blocks
+  uint64 used;                      ///< time of last use (LRU)
+  bool   valid;                     ///< entry in use
+  bool   sequential;                ///< at least two sequential requests
+} PrefetchStream;
+
+//------------------------------------------------------------------------------
+/// @brief readahead for a BlockCache
+///
+/// The prefetcher tracks up to PREFETCH_STREAMS concurrent sequential streams.
+/// A read continues a stream if it starts between the first block of the
+/// stream's last request and the end of the stream; other reads start a new
+/// stream in place of the least recently used one. Once a read has extended
+/// its stream, a read of the stream that misses in the cache also reads the
+/// stream's window of blocks that follow it, in the same disk access.
+///
+/// Read-ahead blocks that are still cached when a read reaches them are
+/// useful; a stream whose reads find all their read-ahead blocks cached
+/// doubles its window once it reaches the end of the window. A read that
+/// finds read-ahead blocks evicted before use halves the window of its
+/// stream. All other read-ahead blocks that are never read are wasted.
+///
+class Prefetcher {
+  public:
+    /// @brief constructor
+    /// @param cache disk cache that holds the read-ahead blocks
+    /// @param nblocks number of blocks on the disk (readahead stops there)
+    Prefetcher(BlockCache *cache, uint64 nblocks);
+
+    /// @brief destructor
+    ~Prefetcher(void);
+
+    /// @brief a read of @a nblocks blocks starting at @a block is about to
+    ///        be looked up in the cache
+    /// @retval number of blocks to read ahead if the read misses
+    uint64 access(uint64 block, uint64 nblocks);
+
+    /// @brief @a nblocks blocks starting at @a block have been read ahead
+    ///        for the stream of the last access()
+    void prefetched(uint64 block, uint64 nblocks);
+
+    /// @name statistics
+    /// @{
+
+    /// @brief number of blocks read ahead
+    uint64 issued(void) const;
+
+    /// @brief number of read-ahead blocks that were read while cached
+    uint64 useful(void) const;
+
+    /// @brief number of read-ahead blocks not (yet) read while cached
+    uint64 wasted(void) const;
+
+    /// @brief number of read-ahead blocks evicted before they were read
+    uint64 evicted(void) const;
+
+    /// @brief fraction of read-ahead blocks that were useful
+    double accuracy(void) const;
+
+    /// @brief fraction of would-be cache misses served by readahead
+    double coverage(void) const;
+
+    /// @}
+
+    /// @brief write the stream table and counters to checkpoint @a out
+    ///        (section "PREF")
+    void save(CheckpointWriter &out) const;
+
+    /// @brief read the state saved by save() from checkpoint @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    BlockCache *_cache;             ///< disk cache
+    uint64 _nblocks;                ///< number of blocks on the disk
+    vector<PrefetchStream> _stream; ///< stream table
+    PrefetchStream *_last;          ///< stream of the last access()
+    uint64 _clock;                  ///< access counter for LRU
+    uint64 _issued;                 ///< blocks read ahead
+    uint64 _useful;                 ///< read-ahead blocks used
+    uint64 _evicted;                ///< read-ahead blocks evicted unused
+    BlockRuns _pending;             ///< read-ahead blocks not yet read
+    vector<pair<uint64, uint64> > _consumed; ///< scratch for access()
+
+    /// @brief find the stream continued by a read at @a block or replace the
+    ///        least recently used stream
+    PrefetchStream* lookup(uint64 block, uint64 nblocks);
+
+  private:
+    Prefetcher(const Prefetcher&);
+    Prefetcher& operator=(const Prefetcher&);
+};
+
+#endif // __CA_PREFETCH_H__
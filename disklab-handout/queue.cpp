@@ -0,0 +1,339 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief request queue and disk schedulers
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+
+#include "queue.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// DiskScheduler
+//
+DiskScheduler* DiskScheduler::create(const char *name)
+{
+  if (strcmp(name, "fcfs") == 0) return new FCFSScheduler();
+  if (strcmp(name, "sstf") == 0) return new SSTFScheduler();
+  if (strcmp(name, "scan") == 0) return new ScanScheduler();
+  if (strcmp(name, "clook") == 0) return new CLookScheduler();
+  if (strcmp(name, "sptf") == 0) return new SPTFScheduler();
+
+  return NULL;
+}
+
+bool DiskScheduler::is_scheduler(const char *name)
+{
+  DiskScheduler *s = create(name);
+  delete s;
+
+  return s != NULL;
+}
+
+/// @brief distance between tracks @a a and @a b
+static inline uint32 distance(uint32 a, uint32 b)
+{
+  return a > b ? a - b : b - a;
+}
+
+QueuedRequest* FCFSScheduler::pick(const vector<QueuedRequest*> &cand,
+                                   const HDD *hdd, double now)
+{
+  return cand[0];
+}
+
+QueuedRequest* SSTFScheduler::pick(const vector<QueuedRequest*> &cand,
+                                   const HDD *hdd, double now)
+{
+  uint32 head = hdd->head_track();
+  size_t best = 0;
+
+  for (size_t i=1; i<cand.size(); i++) {
+    if (distance(cand[i]->track, head) < distance(cand[best]->track, head)) {
+      best = i;
+    }
+  }
+
+  return cand[best];
+}
+
+QueuedRequest* ScanScheduler::pick(const vector<QueuedRequest*> &cand,
+                                   const HDD *hdd, double now)
+{
+  uint32 head = hdd->head_track();
+
+  //
+  // nearest request in the current direction; reverse if there is none
+  //
+  for (int pass=0; pass<2; pass++) {
+    size_t best = cand.size();
+
+    for (size_t i=0; i<cand.size(); i++) {
+      uint32 t = cand[i]->track;
+      if (_up ? t < head : t > head) continue;
+      if ((best == cand.size()) ||
+          (distance(t, head) < distance(cand[best]->track, head))) {
+        best = i;
+      }
+    }
+    if (best < cand.size()) return cand[best];
+    _up = !_up;
+  }
+
+  return cand[0];
+}
+
+QueuedRequest* CLookScheduler::pick(const vector<QueuedRequest*> &cand,
+                                    const HDD *hdd, double now)
+{
+  uint32 head = hdd->head_track();
+  size_t next = cand.size(), lowest = 0;
+
+  for (size_t i=0; i<cand.size(); i++) {
+    uint32 t = cand[i]->track;
+    if ((t >= head) && ((next == cand.size()) || (t < cand[next]->track))) {
+      next = i;
+    }
+    if (t < cand[lowest]->track) lowest = i;
+  }
+
+  return cand[next < cand.size() ? next : lowest];
+}
+
+void SPTFScheduler::add(QueuedRequest *r)
+{
+  _tracks.insert(make_pair(r->track, r));
+}
+
+void SPTFScheduler::remove(QueuedRequest *r)
+{
+  pair<TrackIndex::iterator, TrackIndex::iterator> range =
+    _tracks.equal_range(r->track);
+
+  for (TrackIndex::iterator it=range.first; it!=range.second; it++) {
+    if (it->second == r) {
+      _tracks.erase(it);
+      return;
+    }
+  }
+}
+
+QueuedRequest* SPTFScheduler::pick(const vector<QueuedRequest*> &cand,
+                                   const HDD *hdd, double now)
+{
+  uint32 head = hdd->head_track();
+  QueuedRequest *best = NULL;
+  double best_time = 0;
+
+  //
+  // evaluate a request; requests still waiting to enter the queue are skipped
+  //
+  auto consider = [&](QueuedRequest *r) {
+    if (r->enter > now) return;
+    double t = hdd->positioning_time(now, r->track, r->angle);
+    if ((best == NULL) || (t < best_time) ||
+        ((t == best_time) && (r->seq < best->seq))) {
+      best = r;
+      best_time = t;
+    }
+  };
+
+  //
+  // walk outwards from the head; the seek time grows with the distance, so a
+  // direction is done once its seek alone is no better than the best so far
+  //
+  TrackIndex::iterator split = _tracks.lower_bound(head);
+
+  for (TrackIndex::iterator it=split; it!=_tracks.end(); it++) {
+    if ((best != NULL) && (hdd->seek_cost(head, it->first) > best_time)) break;
+    consider(it->second);
+  }
+  for (TrackIndex::iterator it=split; it!=_tracks.begin(); ) {
+    it--;
+    if ((best != NULL) && (hdd->seek_cost(head, it->first) > best_time)) break;
+    consider(it->second);
+  }
+
+  return best != NULL ? best : cand[0];
+}
+
+//------------------------------------------------------------------------------
+// DiskQueue
+//
+DiskQueue::DiskQueue(HDD *hdd, DiskScheduler *sched, uint32 depth,
+                     ResultSink *sink)
+  : _hdd(hdd), _sched(sched), _depth(depth), _sink(sink), _t0(0), _now(0),
+    _seq(0), _served(0), _queue_time(0), _service_time(0), _write_time(0)
+{
+  if (_depth < 1) _depth = 1;
+  if (_depth > MAX_QUEUE_DEPTH) _depth = MAX_QUEUE_DEPTH;
+  _device.reserve(_depth);
+  _cand.reserve(_depth);
+}
+
+DiskQueue::~DiskQueue(void)
+{
+  for (size_t i=0; i<_host.size(); i++) delete _host[i];
+  for (size_t i=0; i<_device.size(); i++) delete _device[i];
+  delete _sched;
+}
+
+uint64 DiskQueue::served(void) const
+{
+  return _served;
+}
+
+double DiskQueue::queue_time(void) const
+{
+  return _queue_time;
+}
+
+double DiskQueue::service_time(void) const
+{
+  return _service_time;
+}
+
+double DiskQueue::write_time(void) const
+{
+  return _write_time;
+}
+
+double DiskQueue::makespan(void) const
+{
+  return _now;
+}
+
+void DiskQueue::submit(const TraceRequest &r, const char *comment,
+                       uint32 tenant)
+{
+  uint32 bps = _hdd->bytes_per_sector();
+
+  if (_seq == 0) _t0 = r.ts;
+
+  QueuedRequest *q = new QueuedRequest;
+  q->seq = _seq++;
+  q->ts = r.ts;
+  q->arrival = r.ts - _t0;
+  q->enter = q->arrival;
+  q->rw = r.rw;
+  q->block = r.address / bps;
+  q->nblocks = (r.length + bps-1) / bps;
+  q->track = _hdd->track_of(q->block);
+  q->angle = _hdd->angle_of(q->block);
+  q->tenant = tenant;
+  q->comment = comment;
+
+  // serve everything the disk starts before this arrival
+  run(q->arrival);
+
+  if (_device.size() < _depth) {
+    _device.push_back(q);
+    _sched->add(q);
+  } else {
+    _host.push_back(q);
+  }
+}
+
+void DiskQueue::drain(void)
+{
+  while (!_device.empty()) run(1e300);
+}
+
+void DiskQueue::run(double limit)
+{
+  while (!_device.empty()) {
+    double first = _device[0]->enter;
+    for (size_t i=1; i<_device.size(); i++) {
+      first = min(first, _device[i]->enter);
+    }
+
+    double start = max(_now, first);
+    if (start >= limit) break;
+    dispatch(start);
+  }
+}
+
+void DiskQueue::dispatch(double start)
+{
+  //
+  // choose among the requests present at the start time
+  //
+  _cand.clear();
+  for (size_t i=0; i<_device.size(); i++) {
+    if (_device[i]->enter <= start) _cand.push_back(_device[i]);
+  }
+
+  QueuedRequest *q = _sched->pick(_cand, _hdd, start);
+  _device.erase(find(_device.begin(), _device.end(), q));
+  _sched->remove(q);
+
+  if (!_host.empty()) {
+    QueuedRequest *h = _host.front();
+    _host.pop_front();
+    h->enter = max(h->arrival, start);
+    _device.push_back(h);
+    _sched->add(h);
+  }
+
+  //
+  // serve it
+  //
+  ResultRecord res;
+  res.ts = q->ts;
+  res.rw = q->rw;
+  res.block = q->block;
+  res.nblocks = q->nblocks;
+  res.tenant = q->tenant;
+  res.comment = &q->comment[0];
+  res.queue = start - q->arrival;
+
+  _sink->issue(res);
+
+  double finish = start;
+  switch (q->rw) {
+    case 'r': finish = _hdd->read(start, q->block, q->nblocks); break;
+    case 'w': finish = _hdd->write(start, q->block, q->nblocks); break;
+  }
+  // failed accesses return negative times and take no time on the disk
+  if (finish < start) finish = start;
+  res.latency = finish - start;
+  res.stall = _hdd->stall();
+  res.access = _hdd->last_access();
+  _sink->complete(res);
+
+  _now = finish;
+  _served++;
+  _queue_time += res.queue;
+  _service_time += res.latency;
+  if (q->rw == 'w') _write_time += res.latency;
+
+  delete q;
+}
@@ -0,0 +1,245 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief request queue and disk schedulers
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_QUEUE_H__
+#define __CA_QUEUE_H__
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "hdd.h"
+#include "result.h"
+#include "trace.h"
+using namespace std;
+
+#define MAX_QUEUE_DEPTH 32          ///< max. device queue depth (NCQ)
+
+///@brief request that has arrived but not yet been served
+typedef struct QueuedRequest {
+  uint64 seq;                       ///< arrival order
+  double ts;                        ///< trace timestamp
+  double arrival;                   ///< arrival time (since first request)
+  double enter;                     ///< time it entered the device queue
+  char   rw;                        ///< 'r' or 'w'
+  uint64 block;                     ///< first block
+  uint64 nblocks;                   ///< number of blocks
+  uint32 track;                     ///< track of the first block
+  double angle;                     ///< angular position of the first block
+  uint32 tenant;                    ///< tenant of a merged trace
+  string comment;                   ///< trace comment
+} QueuedRequest;
+
+//------------------------------------------------------------------------------
+/// @brief disk scheduler: chooses the next request from the device queue
+///
+/// Use DiskScheduler::create() to instantiate a scheduler by name.
+/// Schedulers that keep their own index of the device queue maintain it in
+/// add() and remove(); the queue calls them for every request entering or
+/// leaving the device queue.
+///
+class DiskScheduler {
+  public:
+    /// @brief constructor
+    DiskScheduler(void) {};
+
+    /// @brief destructor
+    virtual ~DiskScheduler(void) {};
+
+    /// @brief create a scheduler
+    /// @param name fcfs, sstf, scan, clook or sptf
+    /// @retval DiskScheduler instance or NULL if @a name is unknown
+    static DiskScheduler* create(const char *name);
+
+    /// @brief check whether @a name names a supported scheduler
+    static bool is_scheduler(const char *name);
+
+    /// @brief name of the scheduler
+    virtual const char* name(void) const = 0;
+
+    /// @brief request @a r enters the device queue
+    virtual void add(QueuedRequest *r) {};
+
+    /// @brief request @a r leaves the device queue
+    virtual void remove(QueuedRequest *r) {};
+
+    /// @brief choose the next request to serve
+    /// @param cand requests available at time @a now, in queue order
+    ///        (never empty)
+    /// @param hdd disk (head position)
+    /// @param now dispatch time
+    /// @retval chosen request (one of @a cand)
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now) = 0;
+};
+
+/// @brief first come, first served
+class FCFSScheduler : public DiskScheduler {
+  public:
+    virtual const char* name(void) const { return "fcfs"; }
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now);
+};
+
+/// @brief shortest seek time first (fewest tracks from the head)
+class SSTFScheduler : public DiskScheduler {
+  public:
+    virtual const char* name(void) const { return "sstf"; }
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now);
+};
+
+/// @brief SCAN (elevator): serve the nearest request in the current
+///        direction of the head, reverse when there is none
+class ScanScheduler : public DiskScheduler {
+  public:
+    ScanScheduler(void) : _up(true) {};
+    virtual const char* name(void) const { return "scan"; }
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now);
+
+  protected:
+    bool _up;                       ///< head moves towards higher tracks
+};
+
+/// @brief C-LOOK: serve requests in increasing track order, then jump back
+///        to the lowest requested track
+class CLookScheduler : public DiskScheduler {
+  public:
+    virtual const char* name(void) const { return "clook"; }
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now);
+};
+
+/// @brief shortest positioning time first: serve the request with the lowest
+///        seek plus rotational latency (HDD::positioning_time())
+///
+/// The device queue is indexed by track. pick() walks outwards from the head
+/// track and stops in each direction as soon as the seek alone exceeds the
+/// best positioning time found, since the rotational latency cannot make up
+/// for it. Only the requests near the head are evaluated.
+class SPTFScheduler : public DiskScheduler {
+  public:
+    virtual const char* name(void) const { return "sptf"; }
+    virtual void add(QueuedRequest *r);
+    virtual void remove(QueuedRequest *r);
+    virtual QueuedRequest* pick(const vector<QueuedRequest*> &cand,
+                                const HDD *hdd, double now);
+
+  protected:
+    typedef multimap<uint32, QueuedRequest*> TrackIndex;
+    TrackIndex _tracks;             ///< device queue by track
+};
+
+//------------------------------------------------------------------------------
+/// @brief request queue in front of a disk
+///
+/// Requests arrive at their trace timestamps. Up to @a depth requests are
+/// held in the device queue, from which the scheduler chooses whenever the
+/// disk becomes free; further requests wait in FIFO order for a free slot.
+/// Every request is reported to the result sink when it is served, with its
+/// queueing delay (arrival to start of service) and service time. Times are
+/// in the units of the trace timestamps and HDD latencies (seconds), counted
+/// from the arrival of the first request.
+///
+class DiskQueue {
+  public:
+    /// @brief constructor
+    /// @param hdd disk
+    /// @param sched scheduler (owned by the queue)
+    /// @param depth device queue depth (1..MAX_QUEUE_DEPTH)
+    /// @param sink result output
+    DiskQueue(HDD *hdd, DiskScheduler *sched, uint32 depth, ResultSink *sink);
+
+    /// @brief destructor
+    ~DiskQueue(void);
+
+    /// @brief a request arrives
+    /// @param r request
+    /// @param comment trace comment
+    /// @param tenant tenant of a merged trace
+    void submit(const TraceRequest &r, const char *comment, uint32 tenant=0);
+
+    /// @brief serve all queued requests
+    void drain(void);
+
+    /// @name statistics
+    /// @{
+
+    /// @brief number of requests served
+    uint64 served(void) const;
+
+    /// @brief sum of queueing delays
+    double queue_time(void) const;
+
+    /// @brief sum of service times
+    double service_time(void) const;
+
+    /// @brief sum of service times of writes
+    double write_time(void) const;
+
+    /// @brief time from the first arrival to the last completion
+    double makespan(void) const;
+
+    /// @}
+
+  protected:
+    HDD *_hdd;                      ///< disk
+    DiskScheduler *_sched;          ///< scheduler
+    uint32 _depth;                  ///< device queue depth
+    ResultSink *_sink;              ///< result output
+
+    deque<QueuedRequest*> _host;    ///< waiting for a device queue slot
+    vector<QueuedRequest*> _device; ///< device queue
+    vector<QueuedRequest*> _cand;   ///< scratch: dispatch candidates
+    double _t0;                     ///< timestamp of the first request
+    double _now;                    ///< time the disk becomes free
+    uint64 _seq;                    ///< number of requests submitted
+    uint64 _served;                 ///< number of requests served
+    double _queue_time;             ///< sum of queueing delays
+    double _service_time;           ///< sum of service times
+    double _write_time;             ///< sum of service times of writes
+
+    /// @brief serve requests that start before time @a limit
+    void run(double limit);
+
+    /// @brief serve one request at time @a start
+    void dispatch(double start);
+
+  private:
+    DiskQueue(const DiskQueue&);
+    DiskQueue& operator=(const DiskQueue&);
+};
+
+#endif // __CA_QUEUE_H__
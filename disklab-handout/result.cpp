@@ -0,0 +1,450 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief per-request result output (human, csv, summary)
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "result.h"
+using namespace std;
+
+static const size_t SINK_BUFFER_SIZE = 1 << 20; ///< CSV/binary output buffer
+static const size_t CSV_RECORD_MAX  = 256;      ///< max. length of a record
+
+/// @brief trim whitespace in string s at both ends
+///        Warning: modifies string in-place!
+/// @retval trimmed string
+static char* trim(char *s)
+{
+  if (s == NULL) return NULL;
+
+  //
+  // run through entire 0-terminated string and set
+  // - start: to the first non-whitespace character
+  // - end:   to the last non-whitespace character
+  //
+  char *start = NULL;
+  char *end = NULL;
+  char *p = s;
+
+  while (*p != '\0') {
+    bool white = (*p == ' ') || (*p == '\t');
+
+    if ((start == NULL) && !white) start = p;
+    if (!white) end = p;
+    p++;
+  }
+
+  //
+  // terminate string in-place
+  //
+  if (start == NULL) start = s;
+  if (end != NULL) *(++end) = '\0';
+  else *start = '\0';
+
+  return start;
+}
+
+//------------------------------------------------------------------------------
+// SlowestRequests
+//
+SlowestRequests::SlowestRequests(size_t k)
+  : _k(k)
+{
+}
+
+void SlowestRequests::reset(size_t k)
+{
+  _k = k;
+  _heap.clear();
+  _heap.reserve(k);
+}
+
+void SlowestRequests::insert(const ResultRecord &r)
+{
+  if (_heap.size() == _k) {
+    pop_heap(_heap.begin(), _heap.end(), slower);
+    _heap.pop_back();
+  }
+  _heap.push_back(r);
+  _heap.back().comment = NULL;
+  push_heap(_heap.begin(), _heap.end(), slower);
+}
+
+void SlowestRequests::sorted(vector<ResultRecord> &out) const
+{
+  out = _heap;
+  stable_sort(out.begin(), out.end(), slower);
+}
+
+void SlowestRequests::save(CheckpointWriter &out) const
+{
+  uint64 n = _heap.size();
+  out.put(n);
+  for (const ResultRecord &r : _heap) {
+    out.put(r.ts);
+    out.put(r.rw);
+    out.put(r.block);
+    out.put(r.nblocks);
+    out.put(r.latency);
+    out.put(r.queue);
+    out.put(r.stall);
+    save_access(out, r.access);
+    out.put(r.tenant);
+  }
+}
+
+bool SlowestRequests::restore(CheckpointReader &in)
+{
+  uint64 n;
+  ResultRecord r;
+
+  reset(_k);
+  if (!in.get(n)) return false;
+  r.comment = NULL;
+  for (uint64 i=0; i<n; i++) {
+    if (!in.get(r.ts) || !in.get(r.rw) || !in.get(r.block) ||
+        !in.get(r.nblocks) || !in.get(r.latency) || !in.get(r.queue) ||
+        !in.get(r.stall) || !restore_access(in, r.access) ||
+        !in.get(r.tenant)) return false;
+    if ((r.rw != 'r') && (r.rw != 'w')) return in.fail("corrupt request");
+    add(r);
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// ResultSink
+//
+ResultSink* ResultSink::create(const char *mode, const char *path,
+                               bool verbose)
+{
+  if (strcmp(mode, "summary") == 0) return new SummarySink();
+
+  if (strcmp(mode, "human") == 0) {
+    if (path == NULL) return new HumanSink(&cout, verbose);
+    ofstream *out = new ofstream(path);
+    if (!out->good()) {
+      cout << "Cannot create output file '" << path << "'." << endl;
+      delete out;
+      return NULL;
+    }
+    return new HumanSink(out, verbose);
+  }
+
+  if (strcmp(mode, "csv") == 0) {
+    FILE *out = path == NULL ? stdout : fopen(path, "w");
+    if (out == NULL) {
+      cout << "Cannot create output file '" << path << "'." << endl;
+      return NULL;
+    }
+    return new CsvSink(out);
+  }
+
+  if (strcmp(mode, "binary") == 0) {
+    FILE *out = path == NULL ? stdout : fopen(path, "wb");
+    if (out == NULL) {
+      cout << "Cannot create output file '" << path << "'." << endl;
+      return NULL;
+    }
+    return new BinarySink(out);
+  }
+
+  return NULL;
+}
+
+bool ResultSink::is_mode(const char *mode)
+{
+  return (strcmp(mode, "human") == 0) || (strcmp(mode, "csv") == 0) ||
+         (strcmp(mode, "summary") == 0) || (strcmp(mode, "binary") == 0);
+}
+
+bool ResultSink::human(void) const
+{
+  return false;
+}
+
+bool ResultSink::to_stdout(void) const
+{
+  return false;
+}
+
+bool ResultSink::flush(void)
+{
+  return true;
+}
+
+const LatencyHistogram& ResultSink::latency(char rw) const
+{
+  return _latency[rw == 'w'];
+}
+
+void ResultSink::keep_slowest(size_t k)
+{
+  _slowest.reset(k);
+}
+
+const SlowestRequests& ResultSink::slowest(void) const
+{
+  return _slowest;
+}
+
+void ResultSink::track_tenants(uint32 n)
+{
+  TenantStats t;
+  t.reads = t.writes = 0;
+  t.first = t.last = 0;
+  _tenants.assign(n, t);
+}
+
+const vector<TenantStats>& ResultSink::tenants(void) const
+{
+  return _tenants;
+}
+
+void ResultSink::save(CheckpointWriter &out) const
+{
+  out.section("SINK");
+  _latency[0].save(out);
+  _latency[1].save(out);
+  _slowest.save(out);
+}
+
+bool ResultSink::restore(CheckpointReader &in)
+{
+  return in.section("SINK") && _latency[0].restore(in) &&
+         _latency[1].restore(in) && _slowest.restore(in);
+}
+
+void ResultSink::account(const ResultRecord &r)
+{
+  TenantStats &t = _tenants[r.tenant];
+  double done = r.ts + r.queue + r.latency;
+
+  if (t.reads + t.writes == 0) t.first = t.last = r.ts;
+  t.first = min(t.first, r.ts);
+  t.last = max(t.last, done);
+  t.latency.record(r.latency + r.queue);
+  if (r.rw == 'w') t.writes++;
+  else t.reads++;
+}
+
+//------------------------------------------------------------------------------
+// HumanSink
+//
+HumanSink::HumanSink(ostream *out, bool verbose)
+  : _out(out), _verbose(verbose), _comment(false)
+{
+  _out->precision(7);
+  *_out << fixed;
+}
+
+HumanSink::~HumanSink(void)
+{
+  if (_out != &cout) delete _out;
+}
+
+bool HumanSink::human(void) const
+{
+  return true;
+}
+
+void HumanSink::issue(const ResultRecord &r)
+{
+  ostream &out = *_out;
+  char *trimmed = trim(r.comment);
+
+  //
+  // print access info; the result follows on the same line in write()
+  // (with a verbose disk, the disk's debug output comes in between)
+  //
+  _comment = (trimmed != NULL) && (*trimmed != '\0');
+  if (_comment) out << trimmed << endl;
+  switch (r.rw) {
+    case 'r': out << "read "; break;
+    case 'w': out << "write"; break;
+    default : out << "error in input trace";
+  }
+  out << "(" << setw(8) << r.block << ", " << setw(4) << r.nblocks << ") = ";
+}
+
+void HumanSink::write(const ResultRecord &r)
+{
+  ostream &out = *_out;
+
+  out << r.latency << " ms";
+  if (r.stall > 0) out << " (" << r.stall << " ms flush stall)";
+  if (r.queue > 0) out << " + " << r.queue << " ms queued";
+  out << endl;
+  if (_verbose || _comment) out << endl;
+}
+
+bool HumanSink::flush(void)
+{
+  _out->flush();
+  return _out->good();
+}
+
+//------------------------------------------------------------------------------
+// BufferedSink
+//
+BufferedSink::BufferedSink(FILE *out)
+  : _out(out), _buf(SINK_BUFFER_SIZE), _len(0), _error(false)
+{
+}
+
+BufferedSink::~BufferedSink(void)
+{
+  flush();
+  if (_out != stdout) fclose(_out);
+}
+
+bool BufferedSink::to_stdout(void) const
+{
+  return _out == stdout;
+}
+
+char* BufferedSink::reserve(size_t n)
+{
+  if (_buf.size() - _len < n) flush();
+  return &_buf[_len];
+}
+
+bool BufferedSink::flush(void)
+{
+  if ((_len > 0) && (fwrite(&_buf[0], 1, _len, _out) != _len)) _error = true;
+  _len = 0;
+  if (fflush(_out) != 0) _error = true;
+
+  return !_error;
+}
+
+//------------------------------------------------------------------------------
+// CsvSink
+//
+CsvSink::CsvSink(FILE *out)
+  : BufferedSink(out)
+{
+  const char *hdr = "ts,op,block,blocks,latency_s,queue_s,stall_s,"
+                    "seek_s,rotation_s,transfer_s,tracks,source\n";
+  _len = strlen(hdr);
+  memcpy(&_buf[0], hdr, _len);
+}
+
+void CsvSink::write(const ResultRecord &r)
+{
+  static const char *source[] = { "disk", "cache", "buffer", "flash" };
+  char *p = reserve(CSV_RECORD_MAX), *end = &_buf[0] + _buf.size();
+
+  p = to_chars(p, end, r.ts).ptr;
+  *p++ = ',';
+  *p++ = r.rw;
+  *p++ = ',';
+  p = to_chars(p, end, r.block).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.nblocks).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.latency, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.queue, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.stall, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.access.seek, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.access.rotation, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.access.transfer, chars_format::fixed, 7).ptr;
+  *p++ = ',';
+  p = to_chars(p, end, r.access.tracks).ptr;
+  *p++ = ',';
+  size_t n = strlen(source[r.access.source]);
+  memcpy(p, source[r.access.source], n);
+  p += n;
+  *p++ = '\n';
+
+  _len = p - &_buf[0];
+}
+
+//------------------------------------------------------------------------------
+// BinarySink
+//
+/// @brief store @a v little endian in @a n bytes at @a p
+static unsigned char* put_le(unsigned char *p, uint64 v, int n)
+{
+  for (int i=0; i<n; i++) p[i] = (unsigned char)(v >> (8*i));
+  return p + n;
+}
+
+/// @brief store the bit pattern of @a d little endian at @a p
+static unsigned char* put_double(unsigned char *p, double d)
+{
+  uint64 v;
+  memcpy(&v, &d, sizeof(v));
+  return put_le(p, v, 8);
+}
+
+BinarySink::BinarySink(FILE *out)
+  : BufferedSink(out)
+{
+  unsigned char *p = (unsigned char*)&_buf[0];
+
+  memcpy(p, BINARY_RESULT_MAGIC, 8);
+  p = put_le(p + 8, BINARY_RESULT_VERSION, 4);
+  p = put_le(p, BINARY_RESULT_RECORD, 4);
+  _len = 16;
+}
+
+void BinarySink::write(const ResultRecord &r)
+{
+  unsigned char *p = (unsigned char*)reserve(BINARY_RESULT_RECORD);
+
+  memset(p, 0, BINARY_RESULT_RECORD);
+  p = put_double(p, r.ts);
+  p = put_double(p, r.latency);
+  p = put_double(p, r.queue);
+  p = put_double(p, r.stall);
+  p = put_double(p, r.access.seek);
+  p = put_double(p, r.access.rotation);
+  p = put_double(p, r.access.transfer);
+  p = put_le(p, r.block, 8);
+  p = put_le(p, r.nblocks, 4);
+  p = put_le(p, r.access.tracks, 4);
+  p = put_le(p, (unsigned char)r.rw, 1);
+  p = put_le(p, r.access.source, 1);
+
+  _len += BINARY_RESULT_RECORD;
+}
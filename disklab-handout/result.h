@@ -0,0 +1,316 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief per-request result output (human, csv, summary)
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_RESULT_H__
+#define __CA_RESULT_H__
+
+#include <cstdio>
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+#include "disk.h"
+#include "hist.h"
+using namespace std;
+
+///@brief result of one simulated request
+typedef struct ResultRecord {
+  double ts;                        ///< arrival timestamp
+  char   rw;                        ///< 'r' or 'w'
+  uint64 block;                     ///< first block
+  uint64 nblocks;                   ///< number of blocks
+  double latency;                   ///< service time (valid in complete())
+  double queue;                     ///< queueing delay before service
+  double stall;                     ///< part of latency spent waiting for
+                                    ///< write-back destaging
+  DiskAccess access;                ///< breakdown of the rest of the latency
+  uint32 tenant;                    ///< tenant of a merged trace (else 0)
+  char  *comment;                   ///< trace comment (may be modified)
+} ResultRecord;
+
+///@brief requests of one tenant of a merged trace
+typedef struct TenantStats {
+  LatencyHistogram latency;         ///< response times
+  uint64 reads;                     ///< number of reads
+  uint64 writes;                    ///< number of writes
+  double first;                     ///< first arrival
+  double last;                      ///< last completion
+} TenantStats;
+
+//------------------------------------------------------------------------------
+/// @brief the K requests with the longest response time (queueing delay +
+///        service time)
+///
+/// The requests are kept in a min-heap of at most K records whose root is
+/// the fastest of them; a request replaces the root if it is slower. Ties
+/// keep the earlier request. Comments are not kept.
+///
+class SlowestRequests {
+  public:
+    /// @brief constructor
+    /// @param k number of requests to keep (0: off)
+    SlowestRequests(size_t k=0);
+
+    /// @brief set the number of requests to keep and forget the kept ones
+    void reset(size_t k);
+
+    /// @brief consider request @a r
+    void add(const ResultRecord &r)
+    {
+      if (_k == 0) return;
+      if ((_heap.size() == _k) && !slower(r, _heap.front())) return;
+      insert(r);
+    }
+
+    /// @brief return the kept requests, slowest first
+    void sorted(vector<ResultRecord> &out) const;
+
+    /// @brief write the kept requests to checkpoint @a out
+    void save(CheckpointWriter &out) const;
+
+    /// @brief forget the kept requests and consider those read from
+    ///        checkpoint @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    size_t _k;                      ///< number of requests to keep
+    vector<ResultRecord> _heap;     ///< kept requests (min-heap)
+
+    /// @brief true if @a a has a longer response time than @a b (as heap
+    ///        order, this puts the fastest request at the root)
+    static bool slower(const ResultRecord &a, const ResultRecord &b)
+    {
+      return a.latency + a.queue > b.latency + b.queue;
+    }
+
+    /// @brief put @a r into the heap, dropping the root if it is full
+    void insert(const ResultRecord &r);
+};
+
+//------------------------------------------------------------------------------
+/// @brief output of per-request simulation results
+///
+/// The simulation loop calls issue() before and complete() after a request
+/// is sent to the disk. Use ResultSink::create() to instantiate a sink by
+/// mode name:
+/// - human:   the classic one-line-per-request format on stdout
+/// - csv:     one record per request, formatted into a large buffer
+/// - summary: nothing per request; only the totals are printed
+/// - binary:  fixed-size records with the latency breakdown (see BinarySink)
+///
+/// Every sink records the response time (queueing delay + service time) of
+/// the completed requests in a latency histogram for reads and one for
+/// writes and, if enabled, keeps the slowest requests and per-tenant
+/// statistics; the sinks format the records in write().
+///
+class ResultSink {
+  public:
+    /// @brief constructor
+    ResultSink(void) {};
+
+    /// @brief destructor
+    virtual ~ResultSink(void) {};
+
+    /// @brief create a sink for output mode @a mode
+    /// @param mode output mode (human, csv, summary, binary)
+    /// @param path output file (NULL: stdout)
+    /// @param verbose verbose output
+    /// @retval ResultSink instance or NULL on failure
+    static ResultSink* create(const char *mode, const char *path,
+                              bool verbose=false);
+
+    /// @brief check whether @a mode names a supported output mode
+    static bool is_mode(const char *mode);
+
+    /// @brief true if the sink prints the classic header and progress lines
+    virtual bool human(void) const;
+
+    /// @brief true if the sink writes its records to stdout; the driver
+    ///        then prints its own messages on stderr
+    virtual bool to_stdout(void) const;
+
+    /// @brief request @a r is about to be sent to the disk
+    virtual void issue(const ResultRecord &r) {};
+
+    /// @brief request @a r has completed
+    void complete(const ResultRecord &r)
+    {
+      _latency[r.rw == 'w'].record(r.latency + r.queue);
+      _slowest.add(r);
+      if (!_tenants.empty()) account(r);
+      write(r);
+    }
+
+    /// @brief write buffered output
+    /// @retval true on success
+    virtual bool flush(void);
+
+    /// @brief latency histogram of the reads (@a rw = 'r') or writes ('w')
+    const LatencyHistogram& latency(char rw) const;
+
+    /// @brief keep the @a k slowest requests (0: off)
+    void keep_slowest(size_t k);
+
+    /// @brief the slowest requests
+    const SlowestRequests& slowest(void) const;
+
+    /// @brief keep statistics of @a n tenants (0: off)
+    void track_tenants(uint32 n);
+
+    /// @brief statistics of the tenants
+    const vector<TenantStats>& tenants(void) const;
+
+    /// @brief write the latency histograms and the slowest requests to
+    ///        checkpoint @a out (section "SINK")
+    void save(CheckpointWriter &out) const;
+
+    /// @brief read the state saved by save() from checkpoint @a in
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    LatencyHistogram _latency[2];   ///< response times of reads, writes
+    SlowestRequests _slowest;       ///< slowest requests
+    vector<TenantStats> _tenants;   ///< per-tenant statistics
+
+    /// @brief add request @a r to the statistics of its tenant
+    void account(const ResultRecord &r);
+
+    /// @brief format completed request @a r
+    virtual void write(const ResultRecord &r) = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief human-readable format on cout (or a file)
+///
+class HumanSink : public ResultSink {
+  public:
+    /// @brief constructor
+    /// @param out output stream (owned by the sink unless it is cout)
+    /// @param verbose print an empty line after every request
+    HumanSink(ostream *out, bool verbose);
+
+    /// @brief destructor
+    virtual ~HumanSink(void);
+
+    virtual bool human(void) const;
+    virtual void issue(const ResultRecord &r);
+    virtual bool flush(void);
+
+  protected:
+    virtual void write(const ResultRecord &r);
+
+    ostream *_out;                  ///< output stream
+    bool  _verbose;                 ///< verbose output
+    bool  _comment;                 ///< last request had a comment
+};
+
+//------------------------------------------------------------------------------
+/// @brief base of the sinks that format records into a buffer that is
+///        written out when full
+///
+class BufferedSink : public ResultSink {
+  public:
+    /// @brief constructor
+    /// @param out output stream
+    BufferedSink(FILE *out);
+
+    /// @brief destructor; flushes and closes the output file unless stdout
+    virtual ~BufferedSink(void);
+
+    virtual bool to_stdout(void) const;
+    virtual bool flush(void);
+
+  protected:
+    FILE *_out;                     ///< output stream
+    vector<char> _buf;              ///< output buffer
+    size_t _len;                    ///< bytes used in _buf
+    bool   _error;                  ///< a write failed
+
+    /// @brief make room for a record of up to @a n bytes
+    /// @retval position of the record in _buf
+    char* reserve(size_t n);
+};
+
+//------------------------------------------------------------------------------
+/// @brief one comma-separated record per request
+///
+/// Records are formatted with to_chars(). The timestamp is that of the
+/// trace; latencies are in seconds, with seven decimals. Source is disk,
+/// cache, buffer or flash.
+///
+class CsvSink : public BufferedSink {
+  public:
+    /// @brief constructor; writes the header line
+    /// @param out output stream
+    CsvSink(FILE *out);
+
+  protected:
+    virtual void write(const ResultRecord &r);
+};
+
+#define BINARY_RESULT_MAGIC   "DLRESLT1" ///< file magic (8 bytes)
+#define BINARY_RESULT_VERSION 1          ///< format version
+#define BINARY_RESULT_RECORD  80         ///< size of a record
+
+//------------------------------------------------------------------------------
+/// @brief binary result format
+///
+///   header  magic "DLRESLT1", uint32 version, uint32 record size
+///   record  double ts, latency, queue, stall, seek, rotation, transfer,
+///           uint64 block, uint32 nblocks, uint32 tracks, uint8 op ('r',
+///           'w'), uint8 source (AccessSource), 6 bytes pad
+///
+/// ts is the trace timestamp; latency and its breakdown are in seconds.
+/// All values are little endian; doubles are stored as their bit patterns.
+/// Comments are not stored.
+///
+class BinarySink : public BufferedSink {
+  public:
+    /// @brief constructor; writes the header
+    /// @param out output stream
+    BinarySink(FILE *out);
+
+  protected:
+    virtual void write(const ResultRecord &r);
+};
+
+//------------------------------------------------------------------------------
+/// @brief totals only
+///
+class SummarySink : public ResultSink {
+  protected:
+    virtual void write(const ResultRecord &r) {};
+};
+
+#endif // __CA_RESULT_H__
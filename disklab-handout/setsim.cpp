@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief offline set-partitioned simulation of set-associative caches
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+
+#include "cache_policy.h"
+#include "setsim.h"
+using namespace std;
+
+/// @brief run the partitioned simulation with a @a WAYS-way cache
+template <uint32 WAYS>
+static void run(uint32 nblocks, const vector<CacheRequest> &stream,
+                uint32 nthreads, uint64 *hits, uint64 *misses)
+{
+  SetAssocPolicy<WAYS> cache(nblocks);
+  uint32 nsets = cache.sets();
+  if (nthreads > nsets) nthreads = nsets;
+  if (nthreads == 0) nthreads = 1;
+
+  //
+  // bucket[t][o]: blocks accessed by slice t of the stream in sets owned by
+  // thread o, get[t][o]: whether each access is a get. Thread o owns the sets
+  // [o*nsets/nthreads, (o+1)*nsets/nthreads).
+  //
+  vector<vector<vector<uint64> > > bucket(nthreads,
+                                          vector<vector<uint64> >(nthreads));
+  vector<vector<vector<bool> > > get(nthreads,
+                                     vector<vector<bool> >(nthreads));
+  vector<uint64> hit(nthreads, 0), miss(nthreads, 0);
+  vector<thread> worker;
+
+  //
+  // phase 1: partition
+  //
+  for (uint32 t=0; t<nthreads; t++) {
+    worker.push_back(thread([&, t]() {
+      size_t lo = stream.size()*t/nthreads, hi = stream.size()*(t+1)/nthreads;
+      for (size_t i=lo; i<hi; i++) {
+        const CacheRequest &r = stream[i];
+        for (uint64 b=r.block; b<r.block+r.nblocks; b++) {
+          uint32 o = (uint32)((uint64)cache.set_of(b)*nthreads/nsets);
+          bucket[t][o].push_back(b);
+          get[t][o].push_back(r.get);
+        }
+      }
+    }));
+  }
+  for (uint32 t=0; t<nthreads; t++) worker[t].join();
+  worker.clear();
+
+  //
+  // phase 2: simulate; each thread only touches its own sets
+  //
+  for (uint32 o=0; o<nthreads; o++) {
+    worker.push_back(thread([&, o]() {
+      uint64 h = 0, m = 0;
+      for (uint32 t=0; t<nthreads; t++) {
+        const vector<uint64> &acc = bucket[t][o];
+        const vector<bool> &is_get = get[t][o];
+        for (size_t i=0; i<acc.size(); i++) {
+          bool hit = cache.access(acc[i]);
+          if (is_get[i]) {
+            if (hit) h++;
+            else m++;
+          }
+        }
+      }
+      hit[o] = h;
+      miss[o] = m;
+    }));
+  }
+  for (uint32 o=0; o<nthreads; o++) worker[o].join();
+
+  *hits = *misses = 0;
+  for (uint32 o=0; o<nthreads; o++) {
+    *hits += hit[o];
+    *misses += miss[o];
+  }
+}
+
+bool setsim(const char *policy, uint32 nblocks,
+            const vector<CacheRequest> &stream, uint32 nthreads,
+            uint64 *hits, uint64 *misses)
+{
+  switch (BlockCache::ways(policy)) {
+    case 4:  run<4>(nblocks, stream, nthreads, hits, misses); break;
+    case 8:  run<8>(nblocks, stream, nthreads, hits, misses); break;
+    case 16: run<16>(nblocks, stream, nthreads, hits, misses); break;
+    default: return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief offline set-partitioned simulation of set-associative caches
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SETSIM_H__
+#define __CA_SETSIM_H__
+
+#include <vector>
+
+#include "types.h"
+using namespace std;
+
+///@brief a cache request: @a nblocks blocks starting at @a block, either
+///       looked up (get, counts hits/misses) or encached (put)
+typedef struct CacheRequest {
+  uint64 block;                     ///< first block
+  uint64 nblocks;                   ///< number of blocks
+  bool   get;                       ///< true: get_range(), false: put_range()
+} CacheRequest;
+
+/// @brief simulate a set-associative BlockCache on a request stream in
+///        parallel.
+///
+/// The sets of a set-associative cache are independent, so the block stream
+/// is partitioned by set index: each of @a nthreads threads first sorts its
+/// slice of the request stream into per-owner buckets, then every thread
+/// replays the buckets of the sets it owns in stream order. The hit/miss
+/// counts are identical to a serial run of the same stream.
+///
+/// @param policy set-associative policy (sa4, sa8, sa16)
+/// @param nblocks number of cache blocks
+/// @param stream request stream
+/// @param nthreads number of threads
+/// @param hits (output) number of cache hits
+/// @param misses (output) number of cache misses
+/// @retval true on success, false if @a policy is not set-associative
+bool setsim(const char *policy, uint32 nblocks,
+            const vector<CacheRequest> &stream, uint32 nthreads,
+            uint64 *hits, uint64 *misses);
+
+#endif // __CA_SETSIM_H__
@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief flash disk (SSD) with a page-mapped FTL
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iostream>
+
+#include "ssd.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// SSD
+//
+SSD::SSD(uint32 channels, uint32 dies, uint32 pages_per_block,
+         uint32 page_size, uint32 sector_size, uint64 capacity,
+         double overprovision, double t_read, double t_program,
+         double t_erase, double t_transfer)
+  : _channels(channels), _ndies(channels * dies), _ppb(pages_per_block),
+    _page_blocks(page_size / sector_size), _pages(capacity / page_size),
+    _t_read(t_read), _t_program(t_program), _t_erase(t_erase),
+    _t_transfer(t_transfer), _die(_ndies), _channel(channels, 0.0),
+    _l2p(_pages, SSD_INVALID), _next_die(0), _host_writes(0), _gc_writes(0),
+    _erases(0)
+{
+  //
+  // physical blocks: logical capacity plus over-provisioning, spread evenly
+  // over the dies, plus enough blocks per die to always run GC
+  //
+  uint64 physical = (uint64)(_pages * (1.0 + overprovision)) + _ppb - 1;
+  _die_blocks = (physical / _ppb + _ndies - 1) / _ndies + SSD_GC_THRESHOLD + 1;
+
+  uint32 blocks = _die_blocks * _ndies;
+  _p2l.assign((uint64)blocks * _ppb, SSD_INVALID);
+  _valid.assign(blocks, 0);
+  _erased.assign(blocks, true);
+
+  for (uint32 d=0; d<_ndies; d++) {
+    _die[d].free_at = 0;
+    _die[d].active = SSD_INVALID;
+    _die[d].next_page = _ppb;
+    for (uint32 b=0; b<_die_blocks; b++) {
+      _die[d].free.push_back(d*_die_blocks + b);
+    }
+  }
+}
+
+SSD::~SSD(void)
+{
+}
+
+uint64 SSD::pages(void) const
+{
+  return _pages;
+}
+
+uint32 SSD::page_blocks(void) const
+{
+  return _page_blocks;
+}
+
+uint32 SSD::dies(void) const
+{
+  return _ndies;
+}
+
+uint64 SSD::host_writes(void) const
+{
+  return _host_writes;
+}
+
+uint64 SSD::gc_writes(void) const
+{
+  return _gc_writes;
+}
+
+uint64 SSD::erases(void) const
+{
+  return _erases;
+}
+
+double SSD::write_amplification(void) const
+{
+  return _host_writes > 0
+    ? (double)(_host_writes + _gc_writes) / _host_writes : 0.0;
+}
+
+double SSD::read(double ts, uint64 block, uint64 nblocks)
+{
+  if (nblocks == 0) return ts;
+  if (block + nblocks > _pages * _page_blocks) {
+    cout << "SSD: access beyond the capacity (block " << block << ")." << endl;
+    return -1.0;
+  }
+
+  double end = ts;
+  uint64 last = (block + nblocks - 1) / _page_blocks;
+  for (uint64 lpn=block/_page_blocks; lpn<=last; lpn++) {
+    end = max(end, read_page(ts, lpn));
+  }
+
+  return end;
+}
+
+double SSD::write(double ts, uint64 block, uint64 nblocks)
+{
+  if (nblocks == 0) return ts;
+  if (block + nblocks > _pages * _page_blocks) {
+    cout << "SSD: access beyond the capacity (block " << block << ")." << endl;
+    return -1.0;
+  }
+
+  double end = ts;
+  uint64 last = (block + nblocks - 1) / _page_blocks;
+  for (uint64 lpn=block/_page_blocks; lpn<=last; lpn++) {
+    end = max(end, write_page(ts, lpn));
+  }
+
+  return end;
+}
+
+double SSD::read_page(double ts, uint64 lpn)
+{
+  uint32 ppn = _l2p[lpn];
+  uint32 d = ppn != SSD_INVALID ? die_of(ppn) : lpn % _ndies;
+  Die &die = _die[d];
+  double &channel = _channel[d % _channels];
+
+  // sense the page into the die's register, then move it over the channel
+  die.free_at = max(ts, die.free_at) + _t_read;
+  channel = max(die.free_at, channel) + _t_transfer;
+
+  return channel;
+}
+
+double SSD::write_page(double ts, uint64 lpn)
+{
+  //
+  // next die in round-robin order that can take a page
+  //
+  uint32 d = _next_die;
+  for (uint32 i=0; i<_ndies; i++) {
+    d = (_next_die + i) % _ndies;
+    if ((_die[d].next_page < _ppb) || !_die[d].free.empty()) break;
+  }
+  _next_die = (d + 1) % _ndies;
+
+  if (place(d, lpn) == SSD_INVALID) {
+    cout << "SSD: no free pages." << endl;
+    return -1.0;
+  }
+  _host_writes++;
+
+  // move the page over the channel, then program it
+  Die &die = _die[d];
+  double &channel = _channel[d % _channels];
+  channel = max(ts, channel) + _t_transfer;
+  die.free_at = max(channel, die.free_at) + _t_program;
+
+  double end = die.free_at;
+  if (die.free.size() < SSD_GC_THRESHOLD) collect(d);
+
+  return end;
+}
+
+uint32 SSD::allocate(uint32 d)
+{
+  Die &die = _die[d];
+
+  if (die.next_page == _ppb) {
+    if (die.free.empty()) return SSD_INVALID;
+    die.active = die.free.front();
+    die.free.pop_front();
+    die.next_page = 0;
+    _erased[die.active] = false;
+  }
+
+  return die.active * _ppb + die.next_page++;
+}
+
+uint32 SSD::place(uint32 d, uint64 lpn)
+{
+  uint32 ppn = allocate(d);
+  if (ppn == SSD_INVALID) return SSD_INVALID;
+
+  uint32 old = _l2p[lpn];
+  if (old != SSD_INVALID) {
+    _p2l[old] = SSD_INVALID;
+    _valid[old / _ppb]--;
+  }
+  _l2p[lpn] = ppn;
+  _p2l[ppn] = lpn;
+  _valid[ppn / _ppb]++;
+
+  return ppn;
+}
+
+void SSD::collect(uint32 d)
+{
+  Die &die = _die[d];
+  uint32 first = d * _die_blocks;
+
+  while (die.free.size() < SSD_GC_THRESHOLD) {
+    //
+    // greedy: the written block with the fewest valid pages
+    //
+    uint32 victim = SSD_INVALID;
+    for (uint32 b=first; b<first+_die_blocks; b++) {
+      if (_erased[b] || (b == die.active)) continue;
+      if ((victim == SSD_INVALID) || (_valid[b] < _valid[victim])) victim = b;
+    }
+    if ((victim == SSD_INVALID) || (_valid[victim] == _ppb)) return;
+
+    //
+    // copy the valid pages within the die (copyback), then erase the block
+    //
+    for (uint32 p=0; (p<_ppb) && (_valid[victim] > 0); p++) {
+      uint32 lpn = _p2l[victim * _ppb + p];
+      if (lpn == SSD_INVALID) continue;
+      if (place(d, lpn) == SSD_INVALID) return;
+      die.free_at += _t_read + _t_program;
+      _gc_writes++;
+    }
+
+    die.free_at += _t_erase;
+    die.free.push_back(victim);
+    _erased[victim] = true;
+    _erases++;
+  }
+}
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief flash disk (SSD) with a page-mapped FTL
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SSD_H__
+#define __CA_SSD_H__
+
+#include <deque>
+#include <vector>
+
+#include "types.h"
+#include "disk.h"
+using namespace std;
+
+#define SSD_GC_THRESHOLD 2          ///< free blocks per die that trigger GC
+#define SSD_INVALID      0xffffffffU ///< unmapped page, no block
+
+//------------------------------------------------------------------------------
+/// @brief flash-based disk (SSD)
+///
+/// The flash consists of channels x dies. A die reads or programs one page
+/// at a time and erases whole blocks; a channel transfers one page at a
+/// time between the controller and a die. Dies and channels work in
+/// parallel, so the pages of a request are served concurrently if they are
+/// on different dies. Unlike HDD, the SSD keeps the time until which every
+/// die and channel is busy, so requests that arrive while earlier ones are
+/// still being served wait for them.
+///
+/// The page-mapped FTL writes every page to the active block of the next
+/// die (round-robin) and invalidates the previous copy; partial pages are
+/// programmed as whole pages. When a die has fewer than SSD_GC_THRESHOLD
+/// free blocks, greedy garbage collection copies the valid pages of the
+/// block with the fewest valid pages within the die and erases it; the die
+/// is busy meanwhile. Logical pages that were never written are read from
+/// the die they would be written to.
+///
+class SSD : public Disk {
+  public:
+    /// @brief constructor
+    /// @param channels number of channels
+    /// @param dies dies per channel
+    /// @param pages_per_block pages per erase block
+    /// @param page_size page size in bytes
+    /// @param sector_size size of a block (the unit of read()/write()), in
+    ///        bytes; divides @a page_size
+    /// @param capacity logical capacity in bytes
+    /// @param overprovision spare capacity as a fraction of @a capacity (> 0)
+    /// @param t_read page read time (seconds)
+    /// @param t_program page program time
+    /// @param t_erase block erase time
+    /// @param t_transfer time to move a page over a channel
+    SSD(uint32 channels, uint32 dies, uint32 pages_per_block,
+        uint32 page_size, uint32 sector_size, uint64 capacity,
+        double overprovision, double t_read, double t_program,
+        double t_erase, double t_transfer);
+
+    /// @brief destructor
+    virtual ~SSD(void);
+
+    /// @name properties
+    /// @{
+
+    /// @brief number of logical pages
+    uint64 pages(void) const;
+
+    /// @brief blocks (sectors) per page
+    uint32 page_blocks(void) const;
+
+    /// @brief number of dies (channels x dies per channel)
+    uint32 dies(void) const;
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    virtual double read(double ts, uint64 block, uint64 nblocks);
+    virtual double write(double ts, uint64 block, uint64 nblocks);
+
+    /// @brief read logical page @a lpn
+    /// @retval time when the page has been transferred
+    double read_page(double ts, uint64 lpn);
+
+    /// @brief write logical page @a lpn
+    /// @retval time when the page has been programmed
+    double write_page(double ts, uint64 lpn);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief pages written by the host
+    uint64 host_writes(void) const;
+
+    /// @brief valid pages copied by garbage collection
+    uint64 gc_writes(void) const;
+
+    /// @brief number of block erases
+    uint64 erases(void) const;
+
+    /// @brief (host + GC page writes) / host page writes
+    double write_amplification(void) const;
+
+    /// @}
+
+  protected:
+    ///@brief state of a die
+    typedef struct {
+      double free_at;               ///< die idle again
+      uint32 active;                ///< block being written
+      uint32 next_page;             ///< next page in the active block
+      deque<uint32> free;           ///< erased blocks (global block index)
+    } Die;
+
+    uint32 _channels;               ///< number of channels
+    uint32 _ndies;                  ///< number of dies
+    uint32 _ppb;                    ///< pages per block
+    uint32 _page_blocks;            ///< blocks (sectors) per page
+    uint32 _die_blocks;             ///< blocks per die
+    uint64 _pages;                  ///< logical pages
+    double _t_read;                 ///< page read time
+    double _t_program;              ///< page program time
+    double _t_erase;                ///< block erase time
+    double _t_transfer;             ///< channel transfer time per page
+
+    vector<Die> _die;               ///< dies
+    vector<double> _channel;        ///< channel idle again
+    vector<uint32> _l2p;            ///< logical -> physical page
+    vector<uint32> _p2l;            ///< physical -> logical page
+    vector<uint32> _valid;          ///< valid pages per block
+    vector<bool> _erased;           ///< block is erased (in a free list)
+    uint32 _next_die;               ///< die for the next write
+
+    uint64 _host_writes;            ///< pages written by the host
+    uint64 _gc_writes;              ///< pages copied by GC
+    uint64 _erases;                 ///< block erases
+
+    /// @brief die of physical page @a ppn
+    uint32 die_of(uint32 ppn) const { return ppn / (_die_blocks * _ppb); }
+
+    /// @brief take the next free page on die @a d; opens a new active block
+    ///        if needed
+    /// @retval physical page or SSD_INVALID if the die is full
+    uint32 allocate(uint32 d);
+
+    /// @brief map @a lpn to a new page on die @a d
+    /// @retval physical page or SSD_INVALID if the die is full
+    uint32 place(uint32 d, uint64 lpn);
+
+    /// @brief garbage-collect die @a d until it has enough free blocks
+    void collect(uint32 d);
+};
+
+#endif // __CA_SSD_H__
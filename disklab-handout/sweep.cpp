@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief parallel sweep of disk configurations over traces
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <memory>
+
+#include "pool.h"
+#include "sweep.h"
+using namespace std;
+
+bool load_trace(const char *path, vector<TraceRequest> &out, uint32 nthreads)
+{
+  TraceReader *in = TraceReader::open(path, nthreads);
+  if (in == NULL) return false;
+
+  bool ok = true;
+  BinaryTraceReader *bin = dynamic_cast<BinaryTraceReader*>(in);
+  if (bin != NULL) {
+    ok = bin->load(out, nthreads);
+  } else {
+    TraceRequest r;
+    out.clear();
+    while (in->next(&r)) out.push_back(r);
+    ok = !in->failed();
+  }
+  delete in;
+
+  return ok;
+}
+
+/// @brief replay @a trace on a fresh disk
+static void simulate(HDD *hdd, const vector<TraceRequest> &trace,
+                     SweepResult *res)
+{
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  uint32 bps = hdd->bytes_per_sector();
+  double t_out;
+
+  res->reads = res->writes = 0;
+  res->time = 0;
+
+  for (size_t i=0; i<trace.size(); i++) {
+    const TraceRequest &r = trace[i];
+    uint64 block = r.address / bps;
+    uint64 nblocks = (r.length + bps-1) / bps;
+
+    t_out = r.ts;
+    switch (r.rw) {
+      case 'r': res->reads++; t_out = hdd->read(r.ts, block, nblocks); break;
+      case 'w': res->writes++; t_out = hdd->write(r.ts, block, nblocks); break;
+    }
+    res->time += t_out - r.ts;
+    res->latency.record(t_out - r.ts);
+  }
+
+  const BlockCache *cache = hdd->cache();
+  res->hits = cache != NULL ? cache->hits() : 0;
+  res->misses = cache != NULL ? cache->misses() : 0;
+  res->seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                          - start).count();
+  res->ok = true;
+}
+
+void sweep(uint32 nconfigs, DiskFactory disk, const vector<char*> &traces,
+           uint32 nthreads, vector<vector<SweepResult> > &result,
+           uint64 *steals)
+{
+  SweepResult none = { false, 0, 0, 0, 0, 0, 0, LatencyHistogram() };
+  result.assign(nconfigs, vector<SweepResult>(traces.size(), none));
+
+  WorkPool pool(nthreads);
+
+  //
+  // one task per trace loads it and then spawns one simulation per
+  // configuration; the simulations share the loaded trace, which is
+  // released after the last of them
+  //
+  for (uint32 t=0; t<traces.size(); t++) {
+    pool.submit([&, t]() {
+      shared_ptr<vector<TraceRequest> > trace(new vector<TraceRequest>());
+      if (!load_trace(traces[t], *trace, 1)) return;
+
+      shared_ptr<const vector<TraceRequest> > shared = trace;
+      for (uint32 c=0; c<nconfigs; c++) {
+        pool.submit([&, c, t, shared]() {
+          HDD *hdd = disk(c);
+          if (hdd == NULL) return;
+          simulate(hdd, *shared, &result[c][t]);
+          delete hdd;
+        });
+      }
+    });
+  }
+  pool.wait();
+
+  if (steals != NULL) *steals = pool.steals();
+}
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief parallel sweep of disk configurations over traces
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SWEEP_H__
+#define __CA_SWEEP_H__
+
+#include <functional>
+#include <vector>
+
+#include "types.h"
+#include "hdd.h"
+#include "hist.h"
+#include "trace.h"
+using namespace std;
+
+///@brief result of one configuration x trace simulation
+typedef struct SweepResult {
+  bool   ok;                        ///< simulation ran
+  uint64 reads;                     ///< number of read requests
+  uint64 writes;                    ///< number of write requests
+  double time;                      ///< sum of request latencies
+  uint64 hits;                      ///< cache hits
+  uint64 misses;                    ///< cache misses
+  double seconds;                   ///< wall-clock time of the simulation
+  LatencyHistogram latency;         ///< request latencies
+} SweepResult;
+
+/// @brief creates a fresh disk for configuration @a config (NULL on error);
+///        called concurrently from several threads
+typedef function<HDD*(uint32 config)> DiskFactory;
+
+/// @brief load a whole trace into memory
+/// @param path trace file
+/// @param out (output) requests (comments are dropped)
+/// @param nthreads decompression/decoding threads
+/// @retval true on success, false if the trace cannot be opened or reading
+///         it stops at an error
+bool load_trace(const char *path, vector<TraceRequest> &out, uint32 nthreads);
+
+/// @brief simulate every configuration on every trace
+///
+/// Every trace is parsed once into an immutable in-memory array shared by
+/// the simulations of all configurations on it. Loading a trace and the
+/// independent simulations are tasks of a work-stealing pool.
+///
+/// @param nconfigs number of configurations
+/// @param disk disk factory
+/// @param traces trace files
+/// @param nthreads number of threads (0: number of cores)
+/// @param result (output) result[c][t] for configuration c and trace t
+/// @param steals (output) number of tasks stolen between workers (or NULL)
+void sweep(uint32 nconfigs, DiskFactory disk, const vector<char*> &traces,
+           uint32 nthreads, vector<vector<SweepResult> > &result,
+           uint64 *steals);
+
+#endif // __CA_SWEEP_H__
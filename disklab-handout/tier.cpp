@@ -0,0 +1,378 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief flash cache tier in front of an HDD
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "tier.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// TieredDisk
+//
+TieredDisk* TieredDisk::create(SSD *ssd, HDD *hdd, const char *admission,
+                               const char *eviction)
+{
+  TierAdmission a;
+  TierEviction e;
+
+  if (strcmp(admission, "all") == 0) a = ADMIT_ALL;
+  else if (strcmp(admission, "write") == 0) a = ADMIT_WRITES;
+  else if (strcmp(admission, "second") == 0) a = ADMIT_SECOND;
+  else {
+    cout << "Unknown admission policy '" << admission << "'." << endl;
+    return NULL;
+  }
+
+  if (strcmp(eviction, "lru") == 0) e = EVICT_LRU;
+  else if (strcmp(eviction, "fifo") == 0) e = EVICT_FIFO;
+  else {
+    cout << "Unknown eviction policy '" << eviction << "'." << endl;
+    return NULL;
+  }
+
+  if ((ssd->page_blocks() == 0) || (ssd->pages() == 0)) {
+    cout << "The flash tier must hold at least one page of at least one "
+         << "sector." << endl;
+    return NULL;
+  }
+
+  return new TieredDisk(ssd, hdd, a, e);
+}
+
+TieredDisk::TieredDisk(SSD *ssd, HDD *hdd, TierAdmission admission,
+                       TierEviction eviction)
+  : _ssd(ssd), _hdd(hdd), _admission(admission), _eviction(eviction),
+    _page_blocks(ssd->page_blocks()), _access(), _stall(0), _hits(0),
+    _misses(0), _admitted(0), _evicted(0), _destaged(0), _last(0)
+{
+  // hand out the slots in ascending order
+  _free.reserve(_ssd->pages());
+  for (uint64 s=_ssd->pages(); s>0; s--) _free.push_back(s-1);
+}
+
+TieredDisk::~TieredDisk(void)
+{
+  delete _ssd;
+  delete _hdd;
+}
+
+const SSD* TieredDisk::ssd(void) const
+{
+  return _ssd;
+}
+
+HDD* TieredDisk::hdd(void) const
+{
+  return _hdd;
+}
+
+uint64 TieredDisk::slots(void) const
+{
+  return _ssd->pages();
+}
+
+const char* TieredDisk::admission(void) const
+{
+  static const char *name[] = { "all", "write", "second" };
+  return name[_admission];
+}
+
+const char* TieredDisk::eviction(void) const
+{
+  static const char *name[] = { "lru", "fifo" };
+  return name[_eviction];
+}
+
+const DiskAccess& TieredDisk::last_access(void) const
+{
+  return _access;
+}
+
+double TieredDisk::stall(void) const
+{
+  return _stall;
+}
+
+uint64 TieredDisk::hits(void) const
+{
+  return _hits;
+}
+
+uint64 TieredDisk::misses(void) const
+{
+  return _misses;
+}
+
+uint64 TieredDisk::admitted(void) const
+{
+  return _admitted;
+}
+
+uint64 TieredDisk::evicted(void) const
+{
+  return _evicted;
+}
+
+uint64 TieredDisk::destaged(void) const
+{
+  return _destaged;
+}
+
+double TieredDisk::read(double ts, uint64 block, uint64 nblocks)
+{
+  _stall = 0;
+  if (nblocks == 0) return ts;
+
+  //
+  // pages in the tier are read from the SSD; note the missed range
+  //
+  double end = ts;
+  uint64 first = block / _page_blocks;
+  uint64 last = (block + nblocks - 1) / _page_blocks;
+  uint64 lo = 0, hi = 0;
+  bool miss = false;
+
+  for (uint64 p=first; p<=last; p++) {
+    Entry *e = lookup(p);
+    if (e != NULL) {
+      end = max(end, _ssd->read_page(ts, e->slot));
+    } else {
+      if (!miss) lo = p;
+      hi = p;
+      miss = true;
+    }
+  }
+
+  DiskAccess disk = DiskAccess();
+  if (!miss) {
+    account(ts, end, false, disk);
+    return end;
+  }
+
+  //
+  // read the missed pages from the HDD, then program the admitted ones
+  //
+  double t = _hdd->read(ts, lo * _page_blocks, (hi-lo+1) * _page_blocks);
+  if (t >= ts) {
+    disk = _hdd->last_access();
+    _stall = _hdd->stall();
+  } else {
+    // failed accesses return negative times and take no time on the disk
+    t = ts;
+  }
+
+  for (uint64 p=lo; p<=hi; p++) {
+    if ((_map.find(p) != _map.end()) || !admit(p, false)) continue;
+    uint32 slot;
+    t = insert(p, t, false, &slot);
+    _ssd->write_page(t, slot);
+  }
+  end = max(end, t);
+
+  account(ts, end, true, disk);
+  return end;
+}
+
+double TieredDisk::write(double ts, uint64 block, uint64 nblocks)
+{
+  _stall = 0;
+  if (nblocks == 0) return ts;
+
+  //
+  // pages in the tier and admitted pages are written to the SSD; note the
+  // range of the others
+  //
+  double end = ts, t = ts;
+  uint64 first = block / _page_blocks;
+  uint64 last = (block + nblocks - 1) / _page_blocks;
+  uint64 lo = 0, hi = 0, destaged = _destaged;
+  bool bypass = false;
+
+  for (uint64 p=first; p<=last; p++) {
+    Entry *e = lookup(p);
+    if (e != NULL) {
+      e->dirty = true;
+      end = max(end, _ssd->write_page(ts, e->slot));
+    } else if (admit(p, true)) {
+      uint32 slot;
+      t = insert(p, t, true, &slot);
+      end = max(end, _ssd->write_page(t, slot));
+    } else {
+      if (!bypass) lo = p;
+      hi = p;
+      bypass = true;
+    }
+  }
+
+  DiskAccess disk = DiskAccess();
+  if (bypass) {
+    uint64 from = max(block, lo * _page_blocks);
+    uint64 to = min(block + nblocks, (hi+1) * _page_blocks);
+    double w = _hdd->write(ts, from, to - from);
+    if (w >= ts) {
+      disk = _hdd->last_access();
+      _stall = _hdd->stall();
+      end = max(end, w);
+    }
+  }
+
+  account(ts, end, bypass || (_destaged > destaged), disk);
+  return end;
+}
+
+double TieredDisk::flush(void)
+{
+  //
+  // write the dirty pages to the HDD in runs of consecutive pages
+  //
+  vector<pair<uint64, uint32> > dirty;
+  for (unordered_map<uint64, Entry>::iterator it=_map.begin();
+       it!=_map.end(); it++) {
+    if (!it->second.dirty) continue;
+    dirty.push_back(make_pair(it->first, it->second.slot));
+    it->second.dirty = false;
+  }
+  sort(dirty.begin(), dirty.end());
+
+  double t = _last;
+  for (size_t i=0; i<dirty.size(); ) {
+    size_t j = i;
+    double r = t;
+    do {
+      r = max(r, _ssd->read_page(t, dirty[j].second));
+      j++;
+    } while ((j < dirty.size()) && (dirty[j].first == dirty[j-1].first + 1));
+
+    double w = _hdd->write(r, dirty[i].first * _page_blocks,
+                           (j-i) * _page_blocks);
+    t = max(r, w);
+    _destaged += j - i;
+    i = j;
+  }
+
+  return t - _last + _hdd->flush();
+}
+
+TieredDisk::Entry* TieredDisk::lookup(uint64 page)
+{
+  unordered_map<uint64, Entry>::iterator it = _map.find(page);
+
+  if (it == _map.end()) {
+    _misses++;
+    return NULL;
+  }
+
+  _hits++;
+  if (_eviction == EVICT_LRU) {
+    _order.splice(_order.end(), _order, it->second.pos);
+  }
+
+  return &it->second;
+}
+
+bool TieredDisk::admit(uint64 page, bool write)
+{
+  switch (_admission) {
+    case ADMIT_ALL: return true;
+    case ADMIT_WRITES: return write;
+    default: break;
+  }
+
+  //
+  // second miss: admit pages found in the window of recent misses
+  //
+  unordered_map<uint64, list<uint64>::iterator>::iterator g =
+    _ghost.find(page);
+  if (g != _ghost.end()) {
+    _ghost_order.erase(g->second);
+    _ghost.erase(g);
+    return true;
+  }
+
+  _ghost[page] = _ghost_order.insert(_ghost_order.end(), page);
+  if (_ghost.size() > slots()) {
+    _ghost.erase(_ghost_order.front());
+    _ghost_order.pop_front();
+  }
+
+  return false;
+}
+
+double TieredDisk::insert(uint64 page, double ts, bool dirty, uint32 *slot)
+{
+  double t = ts;
+
+  //
+  // evict the next victim; a dirty one is written to the HDD first
+  //
+  if (_free.empty()) {
+    unordered_map<uint64, Entry>::iterator v = _map.find(_order.front());
+    if (v->second.dirty) {
+      double r = _ssd->read_page(t, v->second.slot);
+      double w = _hdd->write(r, v->first * _page_blocks, _page_blocks);
+      t = max(r, w);
+      _destaged++;
+    }
+    _free.push_back(v->second.slot);
+    _order.pop_front();
+    _map.erase(v);
+    _evicted++;
+  }
+
+  *slot = _free.back();
+  _free.pop_back();
+
+  Entry e = { *slot, dirty, _order.insert(_order.end(), page) };
+  _map[page] = e;
+  _admitted++;
+
+  return t;
+}
+
+void TieredDisk::account(double ts, double end, bool hdd,
+                         const DiskAccess &disk)
+{
+  double latency = end - ts;
+
+  _access = disk;
+  if (!hdd) {
+    _access.transfer = latency;
+    _access.source = ACCESS_FLASH;
+  } else {
+    // SSD and destaging time beyond the HDD access count as transfer time
+    _access.transfer += latency - (_stall + disk.seek + disk.rotation +
+                                   disk.transfer);
+  }
+  _last = max(_last, end);
+}
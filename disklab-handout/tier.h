@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief flash cache tier in front of an HDD
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TIER_H__
+#define __CA_TIER_H__
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+#include "disk.h"
+#include "hdd.h"
+#include "ssd.h"
+using namespace std;
+
+///@brief which missed pages enter the flash tier
+typedef enum {
+  ADMIT_ALL,                        ///< every missed page
+  ADMIT_WRITES,                     ///< written pages only; reads bypass
+  ADMIT_SECOND                      ///< pages missed twice within a window
+} TierAdmission;
+
+///@brief which page leaves the flash tier when it is full
+typedef enum {
+  EVICT_LRU,                        ///< least recently used
+  EVICT_FIFO                        ///< first admitted
+} TierEviction;
+
+//------------------------------------------------------------------------------
+/// @brief SSD used as a large write-back cache in front of an HDD
+///
+/// The tier caches the HDD in units of SSD pages; every logical page of the
+/// SSD is a cache slot. Pages in the tier are read from and written to the
+/// SSD. Missed pages go to the HDD; on a read miss, the HDD reads the whole
+/// pages from the first to the last missed page and the admitted ones are
+/// then programmed into the SSD in the background (they occupy the dies but
+/// do not delay the request). Written pages that are admitted are only
+/// written to the SSD and become dirty; the others are written to the HDD.
+///
+/// The admission policy decides which missed pages enter the tier:
+/// - all:    every missed page
+/// - write:  written pages only, i.e., the tier is a write buffer
+/// - second: a page is admitted when it misses again while it is among the
+///           last N distinct missed pages (N = number of slots); this keeps
+///           single-use pages of scans and shuffles out of the tier
+///
+/// The eviction policy (lru or fifo) chooses the slot to reuse when the tier
+/// is full. A dirty victim is read from the SSD and written to the HDD
+/// before its slot is reused; this delays the request that evicts it.
+///
+/// The HDD serves every access as if it were idle, as in the single-disk
+/// simulation, while the SSD keeps the busy times of its dies and channels.
+///
+class TieredDisk : public Disk {
+  public:
+    /// @brief create a tier
+    /// @param ssd flash device; its blocks must be the HDD's sectors
+    /// @param hdd disk
+    /// @param admission admission policy (all, write, second)
+    /// @param eviction eviction policy (lru, fifo)
+    /// @retval TieredDisk instance (owns @a ssd and @a hdd) or NULL on
+    ///         failure (@a ssd and @a hdd are not deleted)
+    static TieredDisk* create(SSD *ssd, HDD *hdd, const char *admission,
+                              const char *eviction);
+
+    /// @brief destructor; deletes the SSD and the HDD
+    virtual ~TieredDisk(void);
+
+    /// @name properties
+    /// @{
+
+    /// @brief the flash device
+    const SSD* ssd(void) const;
+
+    /// @brief the disk
+    HDD* hdd(void) const;
+
+    /// @brief number of slots (SSD pages)
+    uint64 slots(void) const;
+
+    /// @brief name of the admission policy
+    const char* admission(void) const;
+
+    /// @brief name of the eviction policy
+    const char* eviction(void) const;
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    virtual double read(double ts, uint64 block, uint64 nblocks);
+    virtual double write(double ts, uint64 block, uint64 nblocks);
+
+    /// @brief write all dirty pages to the HDD and flush the HDD
+    /// @retval time spent
+    double flush(void);
+
+    /// @brief latency breakdown of the last access. Accesses served by the
+    ///        SSD alone have source ACCESS_FLASH and their latency as
+    ///        transfer time; the others report the HDD's breakdown with the
+    ///        time spent on the SSD and on destaging victims added to the
+    ///        transfer time.
+    const DiskAccess& last_access(void) const;
+
+    /// @brief HDD flush stall of the last access
+    double stall(void) const;
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief accessed pages found in the tier
+    uint64 hits(void) const;
+
+    /// @brief accessed pages not found in the tier
+    uint64 misses(void) const;
+
+    /// @brief pages admitted into the tier
+    uint64 admitted(void) const;
+
+    /// @brief pages evicted from the tier
+    uint64 evicted(void) const;
+
+    /// @brief dirty pages written to the HDD (on eviction or flush)
+    uint64 destaged(void) const;
+
+    /// @}
+
+  protected:
+    ///@brief a cached page
+    typedef struct {
+      uint32 slot;                  ///< SSD page
+      bool   dirty;                 ///< not yet written to the HDD
+      list<uint64>::iterator pos;   ///< position in _order
+    } Entry;
+
+    SSD *_ssd;                      ///< flash device
+    HDD *_hdd;                      ///< disk
+    TierAdmission _admission;       ///< admission policy
+    TierEviction _eviction;         ///< eviction policy
+    uint32 _page_blocks;            ///< HDD blocks per page
+
+    unordered_map<uint64, Entry> _map; ///< cached pages
+    list<uint64> _order;            ///< cached pages, next victim first
+    vector<uint32> _free;           ///< unused slots
+    unordered_map<uint64, list<uint64>::iterator> _ghost; ///< recent misses
+    list<uint64> _ghost_order;      ///< recent misses, oldest first
+
+    DiskAccess _access;             ///< breakdown of the last access
+    double _stall;                  ///< HDD stall of the last access
+    uint64 _hits;                   ///< accessed pages in the tier
+    uint64 _misses;                 ///< accessed pages not in the tier
+    uint64 _admitted;               ///< pages admitted
+    uint64 _evicted;                ///< pages evicted
+    uint64 _destaged;               ///< dirty pages written to the HDD
+    double _last;                   ///< end of the latest access
+
+    /// @brief constructor
+    TieredDisk(SSD *ssd, HDD *hdd, TierAdmission admission,
+               TierEviction eviction);
+
+    /// @brief look up page @a page and count the hit or miss
+    /// @retval entry or NULL on a miss
+    Entry* lookup(uint64 page);
+
+    /// @brief decide whether missed page @a page enters the tier
+    bool admit(uint64 page, bool write);
+
+    /// @brief give page @a page a slot, evicting a page if the tier is full
+    /// @param page page
+    /// @param ts time
+    /// @param dirty the page is written
+    /// @param slot (out) the slot
+    /// @retval time when the slot can be programmed
+    double insert(uint64 page, double ts, bool dirty, uint32 *slot);
+
+    /// @brief set _access for an access from @a ts to @a end that used the
+    ///        HDD if @a hdd (breakdown in @a disk)
+    void account(double ts, double end, bool hdd, const DiskAccess &disk);
+
+  private:
+    TieredDisk(const TieredDisk&);
+    TieredDisk& operator=(const TieredDisk&);
+};
+
+#endif // __CA_TIER_H__
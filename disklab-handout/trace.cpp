@@ -0,0 +1,756 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief trace readers (text and binary) and binary trace writer
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace.h"
+#include "bz2trace.h"
+#include "workload.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// encoding helpers
+//
+static const size_t HEADER_SIZE = 40;     ///< size of the file header
+static const size_t CHUNK_HEADER_SIZE = 24; ///< size of a chunk header
+static const size_t INDEX_ENTRY_SIZE = 24;  ///< size of an index entry
+static const size_t TEXT_BUFFER_SIZE = 1 << 20; ///< text trace read buffer
+
+/// @brief store @a v little endian in @a n bytes at @a p
+static void put_le(unsigned char *p, uint64 v, int n)
+{
+  for (int i=0; i<n; i++) p[i] = (unsigned char)(v >> (8*i));
+}
+
+/// @brief load a little endian value of @a n bytes from @a p
+static uint64 get_le(const unsigned char *p, int n)
+{
+  uint64 v = 0;
+  for (int i=0; i<n; i++) v |= (uint64)p[i] << (8*i);
+  return v;
+}
+
+/// @brief bit pattern of a double
+static uint64 dbits(double d)
+{
+  uint64 v;
+  memcpy(&v, &d, sizeof(v));
+  return v;
+}
+
+/// @brief double with bit pattern @a v
+static double bitsd(uint64 v)
+{
+  double d;
+  memcpy(&d, &v, sizeof(d));
+  return d;
+}
+
+/// @brief zigzag-encode a signed difference
+static uint64 zigzag(uint64 diff)
+{
+  return (diff << 1) ^ (uint64)((int64)diff >> 63);
+}
+
+/// @brief decode a zigzag-encoded difference
+static uint64 unzigzag(uint64 v)
+{
+  return (v >> 1) ^ (~(v & 1) + 1);
+}
+
+/// @brief append @a v as LEB128 varint
+static void put_varint(vector<unsigned char> &out, uint64 v)
+{
+  while (v >= 0x80) {
+    out.push_back((unsigned char)(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back((unsigned char)v);
+}
+
+/// @brief decode a LEB128 varint at @a p (bounded by @a end)
+/// @retval false on truncated input
+static bool get_varint(const unsigned char *&p, const unsigned char *end,
+                       uint64 *v)
+{
+  uint64 r = 0;
+  for (int shift=0; (p < end) && (shift < 64); shift+=7) {
+    unsigned char b = *p++;
+    r |= (uint64)(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      *v = r;
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+// TraceReader
+//
+TraceReader* TraceReader::open(const char *path, uint32 nthreads,
+                               uint32 queue)
+{
+  if (path == NULL) return new TextTraceReader(&cin);
+
+  if (WorkloadGenerator::is_spec(path)) {
+    WorkloadGenerator *g = new WorkloadGenerator(path);
+    if (g->valid()) return g;
+    delete g;
+    return NULL;
+  }
+
+  if (Bz2TraceReader::is_bz2(path)) {
+    if (nthreads == 0) nthreads = max(1U, thread::hardware_concurrency());
+    Bz2TraceReader *r = new Bz2TraceReader(path, nthreads, queue);
+    if (r->valid()) return r;
+    cout << "Cannot read trace file '" << path << "'." << endl;
+    delete r;
+    return NULL;
+  }
+
+  if (BinaryTraceReader::is_binary(path)) {
+    BinaryTraceReader *r = new BinaryTraceReader(path);
+    if (r->valid()) return r;
+    cout << "Corrupt binary trace '" << path << "'." << endl;
+    delete r;
+    return NULL;
+  }
+
+  ifstream *in = new ifstream(path);
+  if (!in->good()) {
+    cout << "Cannot open trace file '" << path << "'." << endl;
+    delete in;
+    return NULL;
+  }
+  return new TextTraceReader(in);
+}
+
+char* TraceReader::comment(void)
+{
+  static char empty[1] = { '\0' };
+  return empty;
+}
+
+uint64 TraceReader::skip(uint64 n)
+{
+  TraceRequest r;
+  uint64 i = 0;
+
+  while ((i < n) && next(&r)) i++;
+
+  return i;
+}
+
+bool TraceReader::failed(void) const
+{
+  return false;
+}
+
+//------------------------------------------------------------------------------
+// TextTraceReader
+//
+TextTraceReader::TextTraceReader(istream *in)
+  : _in(in), _buf(TEXT_BUFFER_SIZE+1), _begin(0), _end(0), _eof(false),
+    _failed(false), _line(0), _comment(NULL)
+{
+}
+
+TextTraceReader::~TextTraceReader(void)
+{
+  if (_in != &cin) delete _in;
+}
+
+bool TextTraceReader::failed(void) const
+{
+  return _failed;
+}
+
+uint64 TextTraceReader::line(void) const
+{
+  return _line;
+}
+
+void TextTraceReader::fill(void)
+{
+  size_t left = _end - _begin;
+
+  memmove(&_buf[0], &_buf[_begin], left);
+  _begin = 0;
+  _end = left;
+
+  // a line longer than the buffer
+  if (_end == _buf.size()-1) _buf.resize(2*_buf.size()-1);
+
+  streamsize n = _in->rdbuf()->sgetn(&_buf[_end], _buf.size()-1 - _end);
+  if (n <= 0) _eof = true;
+  else _end += n;
+}
+
+/// @brief true for the whitespace characters skipped by operator>>
+static inline bool is_space(char c)
+{
+  return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
+/// @brief skip whitespace in [@a p, @a end)
+static inline char* skip_space(char *p, char *end)
+{
+  while ((p < end) && is_space(*p)) p++;
+  return p;
+}
+
+/// @brief parse a number in [@a p, @a end) with an optional '+' sign
+/// @retval end of the number or NULL on failure
+template<typename T>
+static inline char* parse_number(char *p, char *end, T *v)
+{
+  if ((p < end) && (*p == '+')) p++;
+  from_chars_result res = from_chars(p, end, *v);
+  return res.ec == errc() ? (char*)res.ptr : NULL;
+}
+
+/// @brief parse a timestamp in [@a p, @a end)
+///
+/// Plain decimals whose digits form an integer below 2^53, with at most 18
+/// of them after the point, are computed as the quotient of two exactly
+/// representable doubles, which is correctly rounded (Clinger's fast path)
+/// and therefore identical to from_chars().
+///
+/// @retval end of the number or NULL on failure
+static inline char* parse_time(char *p, char *end, double *v)
+{
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+  };
+  char *q = p;
+  uint64 m = 0;
+  int digits = 0, frac = 0;
+
+  while ((q < end) && (*q >= '0') && (*q <= '9') && (digits < 19)) {
+    m = m*10 + (*q++ - '0');
+    digits++;
+  }
+  if ((q < end) && (*q == '.')) {
+    q++;
+    while ((q < end) && (*q >= '0') && (*q <= '9') && (digits < 19)) {
+      m = m*10 + (*q++ - '0');
+      digits++;
+      frac++;
+    }
+  }
+
+  if ((digits > 0) && (m < (1ULL << 53)) && (frac <= 18) &&
+      ((q == end) || ((*q != 'e') && (*q != 'E') && ((*q < '0') || (*q > '9'))))) {
+    *v = (double)m / pow10[frac];
+    return q;
+  }
+
+  return parse_number(p, end, v);
+}
+
+bool TextTraceReader::parse(char *p, char *end, TraceRequest *r)
+{
+  p = parse_time(skip_space(p, end), end, &r->ts);
+  if (p == NULL) return false;
+
+  p = skip_space(p, end);
+  if (p == end) return false;
+  r->rw = *p++;
+
+  p = parse_number(skip_space(p, end), end, &r->address);
+  if (p == NULL) return false;
+
+  p = parse_number(skip_space(p, end), end, &r->length);
+  if (p == NULL) return false;
+
+  // the rest of the line is the comment
+  *end = '\0';
+  _comment = p;
+
+  return true;
+}
+
+bool TextTraceReader::next(TraceRequest *r)
+{
+  while (true) {
+    char *p = &_buf[_begin], *e = &_buf[_end];
+    char *nl = (char*)memchr(p, '\n', e - p);
+
+    if (nl == NULL) {
+      if (!_eof) {
+        fill();
+        continue;
+      }
+      // last line without a line break
+      if (p == e) return false;
+      nl = e;
+    }
+    _begin = nl - &_buf[0] + (nl < e ? 1 : 0);
+    _line++;
+
+    //
+    // skip empty and comment lines
+    //
+    char *q = skip_space(p, nl);
+    if ((q == nl) || ((nl - q >= 2) && (q[0] == '/') && (q[1] == '/'))) {
+      continue;
+    }
+
+    if (!parse(p, nl, r)) {
+      cout << "Error: malformed request in line " << _line << " of trace."
+           << endl;
+      _begin = _end;
+      _eof = _failed = true;
+      return false;
+    }
+
+    return true;
+  }
+}
+
+char* TextTraceReader::comment(void)
+{
+  static char empty[1] = { '\0' };
+  return _comment != NULL ? _comment : empty;
+}
+
+//------------------------------------------------------------------------------
+// BinaryTraceReader
+//
+BinaryTraceReader::BinaryTraceReader(const char *path)
+  : _map(NULL), _size(0), _nrequests(0), _nchunks(0), _index(NULL),
+    _cur_chunk(0), _pos(0), _failed(false)
+{
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= HEADER_SIZE)) {
+    void *m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m != MAP_FAILED) {
+      _map = (const unsigned char*)m;
+      _size = st.st_size;
+      madvise(m, _size, MADV_SEQUENTIAL);
+    }
+  }
+  ::close(fd);
+  if (_map == NULL) return;
+
+  //
+  // check header and index
+  //
+  uint64 index_offset = get_le(_map+32, 8);
+  if ((memcmp(_map, BINARY_TRACE_MAGIC, 8) != 0) ||
+      (get_le(_map+8, 4) != BINARY_TRACE_VERSION) ||
+      (index_offset > _size)) {
+    _nchunks = 0;
+    _index = NULL;
+    return;
+  }
+
+  _nrequests = get_le(_map+16, 8);
+  _nchunks = get_le(_map+24, 8);
+  if ((_size - index_offset) / INDEX_ENTRY_SIZE < _nchunks) {
+    _nchunks = 0;
+    return;
+  }
+  _index = _map + index_offset;
+}
+
+BinaryTraceReader::~BinaryTraceReader(void)
+{
+  if (_map != NULL) munmap((void*)_map, _size);
+}
+
+bool BinaryTraceReader::is_binary(const char *path)
+{
+  char magic[8];
+  ifstream in(path, ios::binary);
+
+  return in.read(magic, 8) && (memcmp(magic, BINARY_TRACE_MAGIC, 8) == 0);
+}
+
+bool BinaryTraceReader::valid(void) const
+{
+  return _index != NULL;
+}
+
+uint64 BinaryTraceReader::requests(void) const
+{
+  return _nrequests;
+}
+
+uint64 BinaryTraceReader::chunks(void) const
+{
+  return _nchunks;
+}
+
+BinaryTraceReader::IndexEntry BinaryTraceReader::entry(uint64 c) const
+{
+  const unsigned char *p = _index + c*INDEX_ENTRY_SIZE;
+  IndexEntry e;
+
+  e.offset = get_le(p, 8);
+  e.first = get_le(p+8, 8);
+  e.ts = bitsd(get_le(p+16, 8));
+
+  return e;
+}
+
+bool BinaryTraceReader::next(TraceRequest *r)
+{
+  while (_pos == _chunk.size()) {
+    if (_cur_chunk >= _nchunks) return false;
+    if (!decode_chunk(_cur_chunk++, _chunk)) {
+      cout << "Corrupt chunk " << _cur_chunk-1 << " in binary trace." << endl;
+      _cur_chunk = _nchunks;
+      _chunk.clear();
+      _failed = true;
+      return false;
+    }
+    _pos = 0;
+  }
+
+  *r = _chunk[_pos++];
+  return true;
+}
+
+uint64 BinaryTraceReader::skip(uint64 n)
+{
+  //
+  // number of the next request and of the request to continue at
+  //
+  uint64 cur = _nrequests;
+  if ((_cur_chunk > 0) && !_chunk.empty()) {
+    cur = entry(_cur_chunk-1).first + _pos;
+  } else if (_cur_chunk < _nchunks) {
+    cur = entry(_cur_chunk).first;
+  }
+
+  uint64 target = n < _nrequests - cur ? cur + n : _nrequests;
+  if (target - cur <= _chunk.size() - _pos) {
+    _pos += target - cur;
+    return target - cur;
+  }
+
+  //
+  // find the last chunk starting at or before target and decode it
+  //
+  uint64 lo = 0, hi = _nchunks;
+  while (lo < hi) {
+    uint64 mid = lo + (hi-lo)/2;
+    if (entry(mid).first <= target) lo = mid+1;
+    else hi = mid;
+  }
+
+  _cur_chunk = lo > 0 ? lo-1 : 0;
+  _chunk.clear();
+  _pos = 0;
+  if ((_cur_chunk < _nchunks) && decode_chunk(_cur_chunk, _chunk)) {
+    _pos = min((uint64)_chunk.size(), target - entry(_cur_chunk).first);
+    _cur_chunk++;
+  }
+
+  return target - cur;
+}
+
+bool BinaryTraceReader::failed(void) const
+{
+  return _failed;
+}
+
+void BinaryTraceReader::seek_time(double ts)
+{
+  //
+  // find the last chunk starting before ts, then skip within the chunk
+  //
+  uint64 lo = 0, hi = _nchunks;
+  while (lo < hi) {
+    uint64 mid = lo + (hi-lo)/2;
+    if (entry(mid).ts < ts) lo = mid+1;
+    else hi = mid;
+  }
+
+  _cur_chunk = lo > 0 ? lo-1 : 0;
+  _chunk.clear();
+  _pos = 0;
+
+  if ((_cur_chunk < _nchunks) && decode_chunk(_cur_chunk, _chunk)) {
+    _cur_chunk++;
+    while ((_pos < _chunk.size()) && (_chunk[_pos].ts < ts)) _pos++;
+  }
+}
+
+bool BinaryTraceReader::decode_chunk(uint64 c, vector<TraceRequest> &out) const
+{
+  if (c >= _nchunks) return false;
+
+  IndexEntry e = entry(c);
+  if ((e.offset > _size) || (_size - e.offset < CHUNK_HEADER_SIZE)) {
+    return false;
+  }
+
+  const unsigned char *p = _map + e.offset;
+  uint32 n = get_le(p, 4);
+  unsigned char openc = p[4], shift = p[5];
+  uint64 len[4], total = 0;
+  for (int i=0; i<4; i++) {
+    len[i] = get_le(p+8+4*i, 4);
+    total += len[i];
+  }
+  p += CHUNK_HEADER_SIZE;
+  if ((n > BINARY_TRACE_CHUNK) || (shift > 63) ||
+      (total > (uint64)(_map + _size - p))) {
+    return false;
+  }
+
+  const unsigned char *ts = p, *op = p+len[0], *addr = op+len[1],
+                      *lng = addr+len[2], *end = lng+len[3];
+  const unsigned char *ts_end = op, *addr_end = lng;
+
+  if (((openc == 0) && (len[1] < ((uint64)n+7)/8)) ||
+      ((openc == 1) && (len[1] < n))) {
+    return false;
+  }
+
+  out.resize(n);
+  uint64 prev_ts = 0, prev_end = 0, v;
+  for (uint32 i=0; i<n; i++) {
+    TraceRequest &r = out[i];
+
+    if (!get_varint(ts, ts_end, &v)) return false;
+    prev_ts += unzigzag(v);
+    r.ts = bitsd(prev_ts);
+
+    if (openc == 0) r.rw = (op[i/8] >> (i%8)) & 1 ? 'w' : 'r';
+    else r.rw = (char)op[i];
+
+    if (!get_varint(addr, addr_end, &v)) return false;
+    r.address = prev_end + (unzigzag(v) << shift);
+
+    if (!get_varint(lng, end, &v)) return false;
+    r.length = v << shift;
+
+    prev_end = r.address + r.length;
+  }
+
+  return true;
+}
+
+bool BinaryTraceReader::load(vector<TraceRequest> &out, uint32 nthreads) const
+{
+  if (nthreads == 0) nthreads = 1;
+
+  //
+  // the chunks must cover the requests without gaps or overlaps: chunk c
+  // holds requests first[c]..first[c+1]-1 (the last one up to _nrequests)
+  //
+  vector<uint64> first(_nchunks+1, _nrequests);
+  for (uint64 c=0; c<_nchunks; c++) first[c] = entry(c).first;
+  if (first[0] != 0) return false;
+  for (uint64 c=0; c<_nchunks; c++) {
+    if ((first[c] > first[c+1]) ||
+        (first[c+1] - first[c] > BINARY_TRACE_CHUNK)) {
+      return false;
+    }
+  }
+
+  out.resize(_nrequests);
+
+  vector<thread> worker;
+  vector<char> ok(nthreads, true);
+
+  for (uint32 t=0; t<nthreads; t++) {
+    worker.push_back(thread([&, t]() {
+      vector<TraceRequest> chunk;
+      for (uint64 c=t; c<_nchunks; c+=nthreads) {
+        if (!decode_chunk(c, chunk) ||
+            (chunk.size() != first[c+1] - first[c])) {
+          ok[t] = false;
+          return;
+        }
+        copy(chunk.begin(), chunk.end(), out.begin() + first[c]);
+      }
+    }));
+  }
+  for (uint32 t=0; t<nthreads; t++) worker[t].join();
+
+  for (uint32 t=0; t<nthreads; t++) {
+    if (!ok[t]) return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// BinaryTraceWriter
+//
+BinaryTraceWriter::BinaryTraceWriter(const char *path)
+  : _out(path, ios::binary | ios::trunc), _nrequests(0), _nchunks(0),
+    _offset(HEADER_SIZE), _closed(false)
+{
+  // header is written by close()
+  unsigned char hdr[HEADER_SIZE];
+  memset(hdr, 0, sizeof(hdr));
+  _out.write((const char*)hdr, sizeof(hdr));
+  _chunk.reserve(BINARY_TRACE_CHUNK);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter(void)
+{
+  close();
+}
+
+bool BinaryTraceWriter::valid(void) const
+{
+  return _out.good();
+}
+
+uint64 BinaryTraceWriter::bytes(void) const
+{
+  return _offset;
+}
+
+void BinaryTraceWriter::add(const TraceRequest &r)
+{
+  _chunk.push_back(r);
+  if (_chunk.size() == BINARY_TRACE_CHUNK) flush();
+}
+
+void BinaryTraceWriter::flush(void)
+{
+  if (_chunk.empty()) return;
+
+  uint32 n = _chunk.size();
+
+  //
+  // common trailing zero bits of addresses and lengths
+  //
+  uint64 bits = 0;
+  bool rw_only = true;
+  for (uint32 i=0; i<n; i++) {
+    bits |= _chunk[i].address | _chunk[i].length;
+    if ((_chunk[i].rw != 'r') && (_chunk[i].rw != 'w')) rw_only = false;
+  }
+  unsigned char shift = bits == 0 ? 0 : __builtin_ctzll(bits);
+
+  //
+  // encode columns
+  //
+  vector<unsigned char> col[4];
+  uint64 prev_ts = 0, prev_end = 0;
+
+  if (rw_only) col[1].assign((n+7)/8, 0);
+  for (uint32 i=0; i<n; i++) {
+    const TraceRequest &r = _chunk[i];
+
+    uint64 t = dbits(r.ts);
+    put_varint(col[0], zigzag(t - prev_ts));
+    prev_ts = t;
+
+    if (rw_only) {
+      if (r.rw == 'w') col[1][i/8] |= 1 << (i%8);
+    } else {
+      col[1].push_back((unsigned char)r.rw);
+    }
+
+    put_varint(col[2], zigzag((r.address >> shift) - (prev_end >> shift)));
+    put_varint(col[3], r.length >> shift);
+    prev_end = r.address + r.length;
+  }
+
+  //
+  // chunk header, columns, index entry
+  //
+  unsigned char hdr[CHUNK_HEADER_SIZE];
+  memset(hdr, 0, sizeof(hdr));
+  put_le(hdr, n, 4);
+  hdr[4] = rw_only ? 0 : 1;
+  hdr[5] = shift;
+  for (int i=0; i<4; i++) put_le(hdr+8+4*i, col[i].size(), 4);
+
+  unsigned char ent[INDEX_ENTRY_SIZE];
+  put_le(ent, _offset, 8);
+  put_le(ent+8, _nrequests, 8);
+  put_le(ent+16, dbits(_chunk[0].ts), 8);
+  _index.insert(_index.end(), ent, ent+INDEX_ENTRY_SIZE);
+
+  _out.write((const char*)hdr, sizeof(hdr));
+  _offset += sizeof(hdr);
+  for (int i=0; i<4; i++) {
+    _out.write((const char*)&col[i][0], col[i].size());
+    _offset += col[i].size();
+  }
+
+  _nrequests += n;
+  _nchunks++;
+  _chunk.clear();
+}
+
+bool BinaryTraceWriter::close(void)
+{
+  if (_closed) return _out.good();
+  _closed = true;
+
+  flush();
+
+  uint64 index_offset = _offset;
+  if (!_index.empty()) {
+    _out.write((const char*)&_index[0], _index.size());
+    _offset += _index.size();
+  }
+
+  unsigned char hdr[HEADER_SIZE];
+  memcpy(hdr, BINARY_TRACE_MAGIC, 8);
+  put_le(hdr+8, BINARY_TRACE_VERSION, 4);
+  put_le(hdr+12, BINARY_TRACE_CHUNK, 4);
+  put_le(hdr+16, _nrequests, 8);
+  put_le(hdr+24, _nchunks, 8);
+  put_le(hdr+32, index_offset, 8);
+  _out.seekp(0);
+  _out.write((const char*)hdr, sizeof(hdr));
+  _out.close();
+
+  return !_out.fail();
+}
@@ -0,0 +1,298 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief trace readers (text and binary) and binary trace writer
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TRACE_H__
+#define __CA_TRACE_H__
+
+#include <fstream>
+#include <istream>
+#include <vector>
+
+#include "types.h"
+using namespace std;
+
+#define CMT_SIZE 2048   ///< max. length of comment
+
+///@brief one request of a trace
+typedef struct TraceRequest {
+  double ts;                        ///< arrival timestamp
+  uint64 address;                   ///< byte address
+  uint64 length;                    ///< length in bytes
+  char   rw;                        ///< 'r' or 'w'
+} TraceRequest;
+
+//------------------------------------------------------------------------------
+/// @brief sequential reader of request traces
+///
+/// Use TraceReader::open() to open a trace; the format is detected from the
+/// file contents. A workload spec ("gen:...") opens a generator instead.
+///
+class TraceReader {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    TraceReader(void) {};
+
+    /// @brief destructor
+    virtual ~TraceReader(void) {};
+
+    /// @brief open a trace file (text, bzip2-compressed text or binary) or
+    ///        a synthetic workload (see WorkloadGenerator)
+    /// @param path path to trace file or workload spec (NULL: read text
+    ///        trace from stdin)
+    /// @param nthreads decompression threads for bzip2 traces
+    ///        (0: number of cores)
+    /// @param queue batches of parsed requests a bzip2 trace buffers ahead
+    ///        (0: default, see Bz2TraceReader)
+    /// @retval TraceReader instance or NULL on failure
+    static TraceReader* open(const char *path, uint32 nthreads=0,
+                             uint32 queue=0);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief read the next request
+    /// @param r (output) request
+    /// @retval true if a request was read, false at the end of the trace
+    virtual bool next(TraceRequest *r) = 0;
+
+    /// @brief comment following the last request read (text traces only)
+    /// @retval 0-terminated string, not trimmed (empty if none)
+    virtual char* comment(void);
+
+    /// @brief skip the next @a n requests
+    /// @retval number of requests skipped (less than @a n at the end of the
+    ///         trace)
+    virtual uint64 skip(uint64 n);
+
+    /// @brief true if reading stopped at an error (a malformed line or
+    ///        corrupt data) rather than at the end of the trace; valid once
+    ///        next() has returned false
+    virtual bool failed(void) const;
+
+    /// @}
+};
+
+//------------------------------------------------------------------------------
+/// @brief reader for text traces
+///
+/// One request per line: timestamp, r/w, byte address, length in bytes,
+/// optionally followed by a comment. Empty lines and lines starting with
+/// "//" are skipped; parsing stops with an error at the first malformed line.
+///
+/// The input is read in large blocks and parsed in place: line ends are
+/// located with memchr() and numbers converted with from_chars(), and the
+/// comment is terminated in the buffer instead of being copied.
+///
+class TextTraceReader : public TraceReader {
+  public:
+    /// @brief constructor
+    /// @param in input stream (owned by the reader unless it is cin)
+    TextTraceReader(istream *in);
+
+    /// @brief destructor
+    virtual ~TextTraceReader(void);
+
+    virtual bool next(TraceRequest *r);
+
+    /// @brief comment of the last request; valid until the next call to
+    ///        next()
+    virtual char* comment(void);
+
+    virtual bool failed(void) const;
+
+    /// @brief number of lines read so far
+    uint64 line(void) const;
+
+  protected:
+    istream *_in;                   ///< input stream
+    vector<char> _buf;              ///< read buffer (+1 byte for a '\0')
+    size_t _begin;                  ///< start of unparsed data in _buf
+    size_t _end;                    ///< end of valid data in _buf
+    bool   _eof;                    ///< end of input reached
+    bool   _failed;                 ///< stopped at a malformed line
+    uint64 _line;                   ///< current line number
+    char  *_comment;                ///< comment of last request (in _buf)
+
+    /// @brief move unparsed data to the front of the buffer and read more
+    void fill(void);
+
+    /// @brief parse the request in [@a p, @a end) into @a r
+    /// @retval true on success
+    bool parse(char *p, char *end, TraceRequest *r);
+};
+
+//------------------------------------------------------------------------------
+/// @brief binary columnar trace format
+///
+/// A binary trace consists of a header, a sequence of independently encoded
+/// chunks of up to BINARY_TRACE_CHUNK requests and a chunk index:
+///
+///   header  magic "DLTRACE1", uint32 version, uint32 chunk size,
+///           uint64 #requests, uint64 #chunks, uint64 index offset
+///   chunk   uint32 #requests, uint8 op encoding, uint8 shift, 2 bytes pad,
+///           uint32 byte length of the ts, op, address and length columns,
+///           followed by the four columns
+///   index   per chunk: uint64 file offset, uint64 first request number,
+///           double first timestamp
+///
+/// All integers are little endian. Columns:
+/// - ts: zigzag varint of the difference between the bit patterns of
+///   consecutive timestamps (bit patterns of positive doubles are ordered,
+///   so close timestamps give small differences; lossless)
+/// - op: one bit per request (0 = 'r', 1 = 'w'), or one byte per request if
+///   the chunk contains other op codes
+/// - address: zigzag varint of (address - end of previous request) >> shift
+/// - length: varint of length >> shift
+/// where shift is the number of trailing zero bits common to all addresses
+/// and lengths of the chunk. Delta state is reset at every chunk, so chunks
+/// can be decoded in any order and in parallel. Comments are not stored.
+///
+#define BINARY_TRACE_MAGIC   "DLTRACE1" ///< file magic (8 bytes)
+#define BINARY_TRACE_VERSION 1          ///< format version
+#define BINARY_TRACE_CHUNK   4096       ///< requests per chunk
+
+//------------------------------------------------------------------------------
+/// @brief reader for binary traces
+///
+/// The file is mapped into memory and chunks are decoded straight from the
+/// mapping.
+///
+class BinaryTraceReader : public TraceReader {
+  public:
+    /// @brief constructor; check valid() before use
+    /// @param path path to binary trace
+    BinaryTraceReader(const char *path);
+
+    /// @brief destructor
+    virtual ~BinaryTraceReader(void);
+
+    /// @brief check whether @a path starts with the binary trace magic
+    static bool is_binary(const char *path);
+
+    /// @brief true if the file was mapped and its header/index are valid
+    bool valid(void) const;
+
+    virtual bool next(TraceRequest *r);
+
+    /// @brief skip the next @a n requests; only the chunk of the request
+    ///        following them is decoded
+    virtual uint64 skip(uint64 n);
+    virtual bool failed(void) const;
+
+    /// @brief number of requests in the trace
+    uint64 requests(void) const;
+
+    /// @brief number of chunks in the trace
+    uint64 chunks(void) const;
+
+    /// @brief continue reading at the first request with timestamp >= @a ts
+    void seek_time(double ts);
+
+    /// @brief decode chunk @a c (thread-safe)
+    /// @param c chunk index
+    /// @param out (output) requests of the chunk
+    /// @retval true on success, false if the chunk is corrupt
+    bool decode_chunk(uint64 c, vector<TraceRequest> &out) const;
+
+    /// @brief decode the whole trace using @a nthreads threads
+    /// @retval true on success, false if a chunk is corrupt or the index
+    ///         does not cover the requests without gaps or overlaps
+    bool load(vector<TraceRequest> &out, uint32 nthreads) const;
+
+  protected:
+    ///@brief chunk index entry
+    typedef struct {
+      uint64 offset;                ///< file offset of the chunk
+      uint64 first;                 ///< number of first request
+      double ts;                    ///< timestamp of first request
+    } IndexEntry;
+
+    const unsigned char *_map;      ///< mapped file
+    size_t _size;                   ///< size of mapping
+    uint64 _nrequests;              ///< number of requests
+    uint64 _nchunks;                ///< number of chunks
+    const unsigned char *_index;    ///< chunk index (in the mapping)
+
+    vector<TraceRequest> _chunk;    ///< decoded current chunk
+    uint64 _cur_chunk;              ///< index of the next chunk to decode
+    size_t _pos;                    ///< next request in _chunk
+    bool   _failed;                 ///< stopped at a corrupt chunk
+
+    /// @brief read index entry @a c
+    IndexEntry entry(uint64 c) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief writer for binary traces
+///
+class BinaryTraceWriter {
+  public:
+    /// @brief constructor; check valid() before use
+    /// @param path output file
+    BinaryTraceWriter(const char *path);
+
+    /// @brief destructor; calls close()
+    ~BinaryTraceWriter(void);
+
+    /// @brief true if the file could be opened and no write error occurred
+    bool valid(void) const;
+
+    /// @brief append request @a r
+    void add(const TraceRequest &r);
+
+    /// @brief flush the last chunk, write the index and the header
+    /// @retval true on success
+    bool close(void);
+
+    /// @brief number of bytes written so far
+    uint64 bytes(void) const;
+
+  protected:
+    ofstream _out;                  ///< output file
+    vector<TraceRequest> _chunk;    ///< requests of the current chunk
+    vector<unsigned char> _index;   ///< encoded chunk index
+    uint64 _nrequests;              ///< number of requests written
+    uint64 _nchunks;                ///< number of chunks written
+    uint64 _offset;                 ///< current file offset
+    bool   _closed;                 ///< close() has been called
+
+    /// @brief encode and write the current chunk
+    void flush(void);
+};
+
+#endif // __CA_TRACE_H__
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief convert text traces to the binary columnar trace format
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string.h>
+#include <libgen.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+using namespace std;
+
+/// @brief print usage information. Does not return (exit with @retstat)
+/// @param program program name (argv[0])
+/// @param retstat program exit status
+void help(char *program, int retstat)
+{
+  char *bn = basename(program);
+  cout << "Usage: " << bn << " [-i/--input <TRACE FILE>] -o/--output <BINARY TRACE>"
+         << endl
+       << "       " << bn << " -d/--dump <BINARY TRACE> [--from <TS>]" << endl
+       << endl
+       << "Convert a text trace (stdin if no file given) to the binary "
+       << "columnar trace" << endl
+       << "format read by disklab. --dump prints a binary trace as text, "
+       << "starting at the" << endl
+       << "first request with timestamp TS or later if --from is given; "
+       << "the chunk index" << endl
+       << "locates it without decoding the requests before it." << endl
+       << endl
+       << "Example: " << bn << " -i traces/vm.trace -o vm.bin" << endl
+       << endl;
+
+  exit(retstat);
+}
+
+/// @brief size of file @a path in bytes (0 if unknown)
+static uint64 file_size(const char *path)
+{
+  struct stat st;
+  return stat(path, &st) == 0 ? st.st_size : 0;
+}
+
+/// @brief print a binary trace in text format
+/// @param path binary trace
+/// @param from first timestamp to print (NULL: all requests)
+/// @retval EXIT_SUCCESS or EXIT_FAILURE
+static int dump(const char *path, const char *from)
+{
+  BinaryTraceReader in(path);
+  if (!in.valid()) {
+    cout << "Cannot read binary trace '" << path << "'." << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (from != NULL) {
+    char *end;
+    double ts = strtod(from, &end);
+    if ((*end != '\0') || (end == from)) {
+      cout << "Error: invalid timestamp '" << from << "'." << endl;
+      return EXIT_FAILURE;
+    }
+    in.seek_time(ts);
+  }
+
+  TraceRequest r;
+  cout.precision(17);
+  while (in.next(&r)) {
+    cout << r.ts << " " << r.rw << " " << r.address << " " << r.length
+         << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/// @brief program entry point
+int main(int argc, char *argv[])
+{
+  char *input = NULL, *output = NULL, *dumpfile = NULL, *from = NULL;
+
+  for (int i=1; i<argc; i++) {
+    if ((strcmp(argv[i], "-i") == 0) || (strcmp(argv[i], "--input") == 0)) {
+      if (++i < argc) input = argv[i];
+    } else
+    if ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "--output") == 0)) {
+      if (++i < argc) output = argv[i];
+    } else
+    if ((strcmp(argv[i], "-d") == 0) || (strcmp(argv[i], "--dump") == 0)) {
+      if (++i < argc) dumpfile = argv[i];
+    } else
+    if (strcmp(argv[i], "--from") == 0) {
+      if (++i < argc) from = argv[i];
+    } else
+    if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+      help(argv[0], EXIT_SUCCESS);
+    } else {
+      cout << "Error: unknown argument '" << argv[i] << "'." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+    if (i == argc) {
+      cout << "Error: missing argument after " << argv[i-1] << "." << endl;
+      help(argv[0], EXIT_FAILURE);
+    }
+  }
+
+  if (dumpfile != NULL) return dump(dumpfile, from);
+
+  if (from != NULL) {
+    cout << "Error: --from requires -d/--dump." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if (output == NULL) {
+    cout << "Error: missing output file." << endl;
+    help(argv[0], EXIT_FAILURE);
+  }
+
+  if ((input != NULL) && BinaryTraceReader::is_binary(input)) {
+    cout << "Error: '" << input << "' already is a binary trace." << endl;
+    return EXIT_FAILURE;
+  }
+
+  TraceReader *in = TraceReader::open(input);
+  if (in == NULL) return EXIT_FAILURE;
+
+  BinaryTraceWriter out(output);
+  if (!out.valid()) {
+    cout << "Cannot create output file '" << output << "'." << endl;
+    delete in;
+    return EXIT_FAILURE;
+  }
+
+  TraceRequest r;
+  uint64 n = 0;
+  while (in->next(&r)) {
+    out.add(r);
+    n++;
+  }
+  delete in;
+
+  if (!out.close()) {
+    cout << "Error writing output file '" << output << "'." << endl;
+    return EXIT_FAILURE;
+  }
+
+  uint64 isize = input != NULL ? file_size(input) : 0;
+  cout.precision(2);
+  cout << "converted " << n << " requests: " << out.bytes() << " bytes";
+  if (isize > 0) {
+    cout << " (text: " << isize << " bytes, " << fixed
+         << (double)out.bytes()/isize*100 << "%)";
+  }
+  cout << endl;
+
+  return EXIT_SUCCESS;
+}
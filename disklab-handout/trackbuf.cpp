@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief segmented on-drive track buffer
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+
+#include "trackbuf.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// TrackBuffer
+//
+TrackBuffer::TrackBuffer(uint32 segments, bool zero_latency)
+  : _seg(segments), _zero_latency(zero_latency), _clock(0), _hit(0), _miss(0)
+{
+  for (size_t i=0; i<_seg.size(); i++) _seg[i].valid = false;
+}
+
+TrackBuffer::~TrackBuffer(void)
+{
+}
+
+uint32 TrackBuffer::segments(void) const
+{
+  return (uint32)_seg.size();
+}
+
+bool TrackBuffer::zero_latency(void) const
+{
+  return _zero_latency;
+}
+
+uint64 TrackBuffer::hits(void) const
+{
+  return _hit;
+}
+
+uint64 TrackBuffer::misses(void) const
+{
+  return _miss;
+}
+
+TrackSegment* TrackBuffer::find(uint32 track)
+{
+  for (size_t i=0; i<_seg.size(); i++) {
+    if (_seg[i].valid && (_seg[i].track == track)) return &_seg[i];
+  }
+
+  return NULL;
+}
+
+bool TrackBuffer::lookup(uint32 track, uint64 first, uint64 end)
+{
+  TrackSegment *s = find(track);
+
+  if ((s != NULL) && (s->first <= first) && (end <= s->end)) {
+    s->used = ++_clock;
+    _hit++;
+    return true;
+  }
+
+  _miss++;
+  return false;
+}
+
+void TrackBuffer::fill(uint32 track, uint64 first, uint64 end)
+{
+  TrackSegment *s = find(track);
+
+  //
+  // extend the segment of the track if the ranges touch, otherwise replace
+  // it or the least recently used segment
+  //
+  if (s != NULL) {
+    if ((first <= s->end) && (s->first <= end)) {
+      if (s->first < first) first = s->first;
+      if (s->end > end) end = s->end;
+    }
+  } else {
+    s = &_seg[0];
+    for (size_t i=1; (i<_seg.size()) && s->valid; i++) {
+      if (!_seg[i].valid || (_seg[i].used < s->used)) s = &_seg[i];
+    }
+  }
+
+  s->valid = true;
+  s->track = track;
+  s->first = first;
+  s->end = end;
+  s->used = ++_clock;
+}
+
+void TrackBuffer::invalidate(uint32 track)
+{
+  TrackSegment *s = find(track);
+  if (s != NULL) s->valid = false;
+}
+
+void TrackBuffer::save(CheckpointWriter &out) const
+{
+  uint32 n = _seg.size();
+
+  out.section("TBUF");
+  out.put(n);
+  out.put_bool(_zero_latency);
+  for (const TrackSegment &s : _seg) {
+    out.put(s.track);
+    out.put(s.first);
+    out.put(s.end);
+    out.put(s.used);
+    out.put_bool(s.valid);
+  }
+  out.put(_clock);
+  out.put(_hit);
+  out.put(_miss);
+}
+
+bool TrackBuffer::restore(CheckpointReader &in)
+{
+  uint32 n;
+  bool zero_latency;
+
+  if (!in.section("TBUF") || !in.get(n) || !in.get_bool(zero_latency)) {
+    return false;
+  }
+  if ((n != _seg.size()) || (zero_latency != _zero_latency)) {
+    return in.fail("the track buffer configuration differs");
+  }
+
+  for (TrackSegment &s : _seg) {
+    if (!in.get(s.track) || !in.get(s.first) || !in.get(s.end) ||
+        !in.get(s.used) || !in.get_bool(s.valid)) return false;
+  }
+
+  return in.get(_clock) && in.get(_hit) && in.get(_miss);
+}
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief segmented on-drive track buffer
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TRACKBUF_H__
+#define __CA_TRACKBUF_H__
+
+#include <vector>
+
+#include "types.h"
+#include "checkpoint.h"
+using namespace std;
+
+#define MAX_TRACK_SEGMENTS 256      ///< max. number of buffer segments
+
+///@brief one segment of the track buffer: sectors [first, end) of a track
+typedef struct TrackSegment {
+  uint32 track;                     ///< track
+  uint64 first;                     ///< first buffered sector
+  uint64 end;                       ///< sector following the last buffered
+  uint64 used;                      ///< time of last use (LRU)
+  bool   valid;                     ///< segment in use
+} TrackSegment;
+
+//------------------------------------------------------------------------------
+/// @brief segmented track buffer of a disk drive
+///
+/// The buffer holds up to @a segments (parts of) tracks, as sector ranges of
+/// the track numbers computed by HDD::decode(). A sector covers the blocks at
+/// that position on all surfaces. Segments are replaced in LRU order. With
+/// zero-latency reads, the drive starts reading as soon as the heads arrive
+/// on the track and buffers the whole track; otherwise it buffers the track
+/// from the first requested sector to its end.
+///
+class TrackBuffer {
+  public:
+    /// @brief constructor
+    /// @param segments number of segments (1..MAX_TRACK_SEGMENTS)
+    /// @param zero_latency read-on-arrival
+    TrackBuffer(uint32 segments, bool zero_latency);
+
+    /// @brief destructor
+    ~TrackBuffer(void);
+
+    /// @brief check whether sectors [@a first, @a end) of @a track are
+    ///        buffered; counts a hit or a miss
+    bool lookup(uint32 track, uint64 first, uint64 end);
+
+    /// @brief buffer sectors [@a first, @a end) of @a track
+    void fill(uint32 track, uint64 first, uint64 end);
+
+    /// @brief drop the buffered sectors of @a track
+    void invalidate(uint32 track);
+
+    /// @name properties
+    /// @{
+
+    /// @brief number of segments
+    uint32 segments(void) const;
+
+    /// @brief read-on-arrival
+    bool zero_latency(void) const;
+
+    /// @brief number of reads served from the buffer
+    uint64 hits(void) const;
+
+    /// @brief number of reads not served from the buffer
+    uint64 misses(void) const;
+
+    /// @}
+
+    /// @brief write the segments and counters to checkpoint @a out (section
+    ///        "TBUF")
+    void save(CheckpointWriter &out) const;
+
+    /// @brief read the state saved by save() from checkpoint @a in. The
+    ///        number of segments must be that of the saved buffer.
+    /// @retval true on success
+    bool restore(CheckpointReader &in);
+
+  protected:
+    vector<TrackSegment> _seg;      ///< segments
+    bool   _zero_latency;           ///< read-on-arrival
+    uint64 _clock;                  ///< access counter for LRU
+    uint64 _hit;                    ///< number of hits
+    uint64 _miss;                   ///< number of misses
+
+    /// @brief segment holding @a track or NULL
+    TrackSegment* find(uint32 track);
+};
+
+#endif // __CA_TRACKBUF_H__
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief synthetic workload generator
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "workload.h"
+using namespace std;
+
+static const uint64 ZETA_EXACT = 10000000; ///< zeta terms summed exactly
+static const uint64 SCATTER = 2654435761ULL; ///< prime scattering Zipf ranks
+
+//------------------------------------------------------------------------------
+// Random
+//
+Random::Random(uint64 seed)
+{
+  // splitmix64
+  for (int i=0; i<4; i++) {
+    uint64 z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    _s[i] = z ^ (z >> 31);
+  }
+}
+
+//------------------------------------------------------------------------------
+// WorkloadGenerator
+//
+/// @brief zeta(n, theta) = sum of 1/i^theta for i=1..n. Terms beyond
+///        ZETA_EXACT are approximated by the integral.
+static double zeta(uint64 n, double theta)
+{
+  double sum = 0;
+  uint64 m = n < ZETA_EXACT ? n : ZETA_EXACT;
+
+  for (uint64 i=1; i<=m; i++) sum += pow((double)i, -theta);
+  if (n > m) {
+    sum += (pow(n + 0.5, 1-theta) - pow(m + 0.5, 1-theta)) / (1-theta);
+  }
+  return sum;
+}
+
+bool parse_number(const string &v, double *d)
+{
+  char *end;
+  *d = strtod(v.c_str(), &end);
+  if (end == v.c_str()) return false;
+
+  switch (*end) {
+    case 'k': case 'K': *d *= 1024.0; end++; break;
+    case 'm': case 'M': *d *= 1024.0*1024; end++; break;
+    case 'g': case 'G': *d *= 1024.0*1024*1024; end++; break;
+  }
+  return *end == '\0';
+}
+
+WorkloadGenerator::WorkloadGenerator(const char *spec)
+  : _pattern(UNIFORM), _arrival(POISSON), _valid(false), _count(1000000),
+    _span(16ULL << 30), _align(512), _size_min(4096), _size_max(4096),
+    _reads(0.7), _rate(100), _burst(32), _peak(10), _streams(4), _rng(1),
+    _generated(0), _ts(0), _pos(0), _theta(0.99), _slots(0), _zeta_n(0),
+    _alpha(0), _eta(0)
+{
+  if (!parse(spec)) return;
+
+  _batch.reserve(WORKLOAD_BATCH);
+  for (uint32 s=0; s<_streams; s++) {
+    _stream[s] = _rng.below((_span - _size_max)/_align + 1) * _align;
+  }
+
+  if (_pattern == ZIPF) {
+    _slots = _span / _size_max;
+    _zeta_n = zeta(_slots, _theta);
+    _alpha = 1.0 / (1.0 - _theta);
+    _eta = (1.0 - pow(2.0/_slots, 1.0 - _theta))
+           / (1.0 - (1.0 + pow(0.5, _theta)) / _zeta_n);
+  }
+
+  _valid = true;
+}
+
+bool WorkloadGenerator::is_spec(const char *path)
+{
+  return strncmp(path, WORKLOAD_PREFIX, strlen(WORKLOAD_PREFIX)) == 0;
+}
+
+bool WorkloadGenerator::valid(void) const
+{
+  return _valid;
+}
+
+uint64 WorkloadGenerator::requests(void) const
+{
+  return _count;
+}
+
+bool WorkloadGenerator::parse(const char *spec)
+{
+  if (is_spec(spec)) spec += strlen(WORKLOAD_PREFIX);
+
+  string s = spec;
+  uint64 seed = 1;
+  size_t p = 0;
+
+  while (p < s.size()) {
+    size_t e = s.find(',', p);
+    if (e == string::npos) e = s.size();
+    string item = s.substr(p, e-p);
+    p = e+1;
+    if (item.empty()) continue;
+
+    size_t eq = item.find('=');
+    string key = item.substr(0, eq);
+    string v = eq != string::npos ? item.substr(eq+1) : "";
+    double d = 0;
+    bool number = parse_number(v, &d);
+    bool ok = true;
+
+    if (key == "pattern") {
+      if (v == "uniform") _pattern = UNIFORM;
+      else if (v == "zipf") _pattern = ZIPF;
+      else if (v == "seq") _pattern = SEQUENTIAL;
+      else ok = false;
+    } else
+    if (key == "arrival") {
+      if (v == "poisson") _arrival = POISSON;
+      else if (v == "fixed") _arrival = FIXED;
+      else if (v == "bursty") _arrival = BURSTY;
+      else ok = false;
+    } else
+    if (key == "size") {
+      size_t dash = v.find('-');
+      double lo = 0, hi = 0;
+      ok = parse_number(v.substr(0, dash), &lo) &&
+           parse_number(dash != string::npos ? v.substr(dash+1)
+                                               : v.substr(0, dash), &hi) &&
+           (lo >= 1) && (hi >= lo);
+      _size_min = (uint64)lo;
+      _size_max = (uint64)hi;
+    } else
+    if (!number) {
+      ok = false;
+    } else
+    if (key == "count") { _count = (uint64)d; ok = d >= 0; } else
+    if (key == "seed")  { seed = (uint64)d; } else
+    if (key == "theta") { _theta = d; ok = (d > 0) && (d < 1); } else
+    if (key == "streams") {
+      _streams = (uint32)d;
+      ok = (d >= 1) && (d <= WORKLOAD_STREAMS);
+    } else
+    if (key == "span")  { _span = (uint64)d; } else
+    if (key == "align") { _align = (uint64)d; ok = d >= 1; } else
+    if (key == "reads") { _reads = d; ok = (d >= 0) && (d <= 1); } else
+    if (key == "rate")  { _rate = d; ok = d > 0; } else
+    if (key == "burst") { _burst = (uint32)d; ok = d >= 1; } else
+    if (key == "peak")  { _peak = d; ok = d >= 1; } else {
+      cout << "Unknown workload parameter '" << key << "'." << endl;
+      return false;
+    }
+
+    if (!ok) {
+      cout << "Invalid workload parameter '" << item << "'." << endl;
+      return false;
+    }
+  }
+
+  // sizes are multiples of the alignment
+  _size_min = (_size_min + _align-1) / _align * _align;
+  _size_max = (_size_max + _align-1) / _align * _align;
+  if (_span < _size_max) {
+    cout << "Workload span is smaller than the request size." << endl;
+    return false;
+  }
+
+  _rng = Random(seed);
+  return true;
+}
+
+uint64 WorkloadGenerator::zipf(void)
+{
+  double u = _rng.uniform(), uz = u * _zeta_n;
+
+  if (uz < 1.0) return 0;
+  if (uz < 1.0 + pow(0.5, _theta)) return 1;
+
+  uint64 r = (uint64)(_slots * pow(_eta*u - _eta + 1.0, _alpha));
+  return r < _slots ? r : _slots-1;
+}
+
+double WorkloadGenerator::exponential(double mean)
+{
+  return -log(1.0 - _rng.uniform()) * mean;
+}
+
+bool WorkloadGenerator::fill(void)
+{
+  if (_generated == _count) return false;
+
+  uint64 n = _count - _generated;
+  if (n > WORKLOAD_BATCH) n = WORKLOAD_BATCH;
+  _batch.resize(n);
+  _pos = 0;
+
+  uint64 slots = (_size_max - _size_min) / _align + 1;
+  double gap = _burst/_rate - (_burst-1)/(_rate*_peak);
+
+  for (uint64 i=0; i<n; i++, _generated++) {
+    TraceRequest &r = _batch[i];
+
+    //
+    // arrival
+    //
+    switch (_arrival) {
+      case POISSON: _ts += exponential(1.0/_rate); break;
+      case FIXED:   _ts = _generated / _rate; break;
+      case BURSTY:
+        _ts += _generated % _burst == 0 ? exponential(gap)
+                                        : exponential(1.0/(_rate*_peak));
+        break;
+    }
+    r.ts = _ts;
+
+    //
+    // size, address and operation
+    //
+    r.length = slots > 1 ? _size_min + _rng.below(slots)*_align : _size_min;
+    switch (_pattern) {
+      case UNIFORM:
+        r.address = _rng.below((_span - r.length)/_align + 1) * _align;
+        break;
+
+      case ZIPF: {
+        // scatter the ranks over the slots (bijective unless SCATTER
+        // divides _slots)
+        uint64 rank = zipf();
+        uint64 slot = _slots % SCATTER != 0
+                      ? (uint64)((unsigned __int128)rank * SCATTER % _slots)
+                      : rank;
+        r.address = slot * _size_max;
+        break;
+      }
+
+      case SEQUENTIAL: {
+        uint64 &next = _stream[_streams > 1 ? _rng.below(_streams) : 0];
+        if (next + r.length > _span) {
+          next = _rng.below((_span - _size_max)/_align + 1) * _align;
+        }
+        r.address = next;
+        next += r.length;
+        break;
+      }
+    }
+    r.rw = _rng.uniform() < _reads ? 'r' : 'w';
+  }
+
+  return true;
+}
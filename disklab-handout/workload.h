@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+/// @file
+/// @brief synthetic workload generator
+/// @section changelog Change Log
+/// 2026/10/16 created
+///
+/// @section license_section License
+/// Copyright (c) 2026, Computer Systems and Platforms Laboratory,
+/// Seoul National University. All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_WORKLOAD_H__
+#define __CA_WORKLOAD_H__
+
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "trace.h"
+using namespace std;
+
+#define WORKLOAD_PREFIX "gen:"      ///< trace path prefix of a workload spec
+#define WORKLOAD_BATCH  4096        ///< requests generated at a time
+#define WORKLOAD_STREAMS 64         ///< max. sequential streams
+
+//------------------------------------------------------------------------------
+/// @brief fast deterministic pseudo-random numbers (xoshiro256**)
+///
+/// The sequence depends only on the seed, on every platform.
+///
+class Random {
+  public:
+    /// @brief constructor; the state is initialized from @a seed by splitmix64
+    Random(uint64 seed);
+
+    /// @brief next 64 random bits
+    uint64 next(void)
+    {
+      uint64 r = rotl(_s[1]*5, 7)*9, t = _s[1] << 17;
+      _s[2] ^= _s[0];
+      _s[3] ^= _s[1];
+      _s[1] ^= _s[2];
+      _s[0] ^= _s[3];
+      _s[2] ^= t;
+      _s[3] = rotl(_s[3], 45);
+      return r;
+    }
+
+    /// @brief uniform double in [0,1)
+    double uniform(void) { return (next() >> 11) * (1.0/(1ULL << 53)); }
+
+    /// @brief uniform integer in [0,n)
+    uint64 below(uint64 n) { return (uint64)(uniform()*n); }
+
+  protected:
+    uint64 _s[4];                   ///< state
+
+    static uint64 rotl(uint64 x, int k) { return (x << k) | (x >> (64-k)); }
+};
+
+/// @brief parse number @a v with an optional k, m or g suffix (powers of
+///        1024)
+/// @retval true on success
+bool parse_number(const string &v, double *d);
+
+//------------------------------------------------------------------------------
+/// @brief synthetic workload, read like a trace
+///
+/// The workload is described by a spec of comma-separated key=value pairs
+/// following WORKLOAD_PREFIX, e.g. "gen:pattern=zipf,theta=0.9,rate=500".
+/// TraceReader::open() accepts a spec in place of a trace file, so
+/// generated requests go straight into the simulation without a text
+/// round-trip. Requests are generated in batches of WORKLOAD_BATCH.
+///
+/// Keys (default):
+/// - count    number of requests (1000000)
+/// - seed     random seed (1); the same spec gives the same requests
+/// - pattern  uniform: uniformly random addresses;
+///            zipf:    Zipf-distributed popularity (skew theta) of the
+///                     request-sized slots of the address space, hot slots
+///                     scattered over the space;
+///            seq:     streams sequential streams, each request continues a
+///                     randomly chosen one (uniform)
+/// - theta    Zipf skew, 0 < theta < 1 (0.99)
+/// - streams  number of sequential streams, 1..WORKLOAD_STREAMS (4)
+/// - span     size of the address space in bytes (16 GiB)
+/// - size     request size in bytes, or a range min-max of sizes chosen
+///            uniformly in multiples of align (4096)
+/// - align    alignment of addresses and sizes in bytes (512)
+/// - reads    fraction of reads (0.7)
+/// - arrival  poisson: exponential inter-arrival times;
+///            fixed:   constant inter-arrival time;
+///            bursty:  bursts of burst requests arriving at peak times the
+///                     rate, separated by idle gaps (Poisson within and
+///                     between bursts); the mean rate is rate (poisson)
+/// - rate     mean arrival rate in requests per second (100)
+/// - burst    requests per burst (32)
+/// - peak     rate multiplier within a burst (10)
+///
+/// Sizes accept the suffixes k, m, g (powers of 1024). Timestamps start at 0.
+///
+class WorkloadGenerator : public TraceReader {
+  public:
+    /// @brief constructor; check valid() before use
+    /// @param spec workload spec (with or without WORKLOAD_PREFIX)
+    WorkloadGenerator(const char *spec);
+
+    /// @brief check whether @a path is a workload spec
+    static bool is_spec(const char *path);
+
+    /// @brief true if the spec was parsed without errors
+    bool valid(void) const;
+
+    virtual bool next(TraceRequest *r)
+    {
+      if (_pos == _batch.size() && !fill()) return false;
+      *r = _batch[_pos++];
+      return true;
+    }
+
+    /// @brief number of requests in the workload
+    uint64 requests(void) const;
+
+  protected:
+    enum { UNIFORM, ZIPF, SEQUENTIAL } _pattern;
+    enum { POISSON, FIXED, BURSTY } _arrival;
+
+    bool   _valid;                  ///< spec is valid
+    uint64 _count;                  ///< number of requests
+    uint64 _span;                   ///< address space (bytes)
+    uint64 _align;                  ///< alignment (bytes)
+    uint64 _size_min;               ///< smallest request (bytes)
+    uint64 _size_max;               ///< largest request (bytes)
+    double _reads;                  ///< fraction of reads
+    double _rate;                   ///< mean arrival rate
+    uint32 _burst;                  ///< requests per burst
+    double _peak;                   ///< rate multiplier within bursts
+    uint32 _streams;                ///< sequential streams
+
+    Random _rng;                    ///< random numbers
+    uint64 _generated;              ///< requests generated so far
+    double _ts;                     ///< timestamp of the last request
+    vector<TraceRequest> _batch;    ///< current batch
+    size_t _pos;                    ///< next request in _batch
+    uint64 _stream[WORKLOAD_STREAMS]; ///< next address of every stream
+
+    // Zipf sampling (Gray et al., "Quickly generating billion-record
+    // synthetic databases", SIGMOD'94)
+    double _theta;                  ///< skew
+    uint64 _slots;                  ///< number of request-sized slots
+    double _zeta_n;                 ///< zeta(_slots, theta)
+    double _alpha;                  ///< 1/(1-theta)
+    double _eta;                    ///< see zipf()
+
+    /// @brief parse @a spec
+    /// @retval true on success
+    bool parse(const char *spec);
+
+    /// @brief generate the next batch
+    /// @retval false if all requests have been generated
+    bool fill(void);
+
+    /// @brief random Zipf rank in [0, _slots)
+    uint64 zipf(void);
+
+    /// @brief exponentially distributed time with mean @a mean
+    double exponential(double mean);
+};
+
+#endif // __CA_WORKLOAD_H__